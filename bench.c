@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2025 Rohit Ballurgi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software... [rest of standard MIT short-text]
+ * ...
+ * MIT License (see LICENSE file for full text)
+ */
+#define _POSIX_C_SOURCE 199309L
+#include "doda_engine.h"
+#include "doda_api.h"
+#include "doda_schema.h"
+#include "doda_io.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Micro/macro benchmarks. Output is one JSON object per line:
+// {"config":..,"case":..,"ts":..,"delete_ratio":..,"ops":..,"errors":..,"ns_per_op":..,"rows_per_s":..}
+// errors counts engine calls that failed during the case; any error makes the run exit non-zero.
+
+#ifndef DODA_BENCH_CONFIG
+#define DODA_BENCH_CONFIG "default"
+#endif
+
+// Total rows touched per case; repetitions are derived from MAX_ROWS
+#define BENCH_ROW_BUDGET 400000u
+
+typedef enum { TS_REGULAR = 0, TS_JITTER, TS_OUT_OF_ORDER, TS_MODE_COUNT } TsMode;
+static const char *ts_mode_names[TS_MODE_COUNT] = {"regular", "jitter", "out_of_order"};
+
+static const int delete_pct[] = {0, 10, 50};
+#define DELETE_RATIO_COUNT (sizeof(delete_pct) / sizeof(delete_pct[0]))
+
+#define BENCH_DEVICES 16
+
+static Table g_table;
+static Index g_index;
+static GroupBy g_groups;
+static int g_times[MAX_ROWS];
+static volatile long long g_sink;
+static uint64_t g_errors, g_errors_total;
+#define BENCH_CHECK(cond) ((cond) ? (void)0 : (void)g_errors++)
+
+// Deterministic xorshift32 workload generator
+static uint32_t g_rng;
+static void rng_seed(uint32_t s) { g_rng = s ? s : 0x9e3779b9u; }
+static uint32_t rng_next(void) { uint32_t x = g_rng; x ^= x << 13; x ^= x >> 17; x ^= x << 5; return g_rng = x; }
+
+static uint64_t now_ns(void) {
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts); return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void gen_times(TsMode mode, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        int base = (int)i * 10;
+        g_times[i] = (mode == TS_JITTER) ? base + (int)(rng_next() % 7) - 3 : base;
+    }
+    if (mode == TS_OUT_OF_ORDER) {
+        // Late arrivals: swap each sample with one up to 8 positions back
+        for (size_t i = 1; i < n; ++i) { size_t j = i - 1 - (rng_next() % (i < 8 ? i : 8)); int tmp = g_times[i]; g_times[i] = g_times[j]; g_times[j] = tmp; }
+    }
+}
+
+static const char *bench_cols[] = {"id", "time", "device", "value"};
+static const ColumnType bench_types[] = {COL_INT, COL_INT, COL_INT, COL_INT};
+
+static DSStatus insert4(Table *t, int id, int time, int device, int value) {
+    const void *vals[4]; vals[0] = &id; vals[1] = &time; vals[2] = &device; vals[3] = &value; return insert_row(t, vals);
+}
+
+#define BENCH_SCHEMA(X, ctx) X(ctx, id, INT) X(ctx, time, INT) X(ctx, device, INT) X(ctx, value, INT)
+DODA_SCHEMA(sample, BENCH_SCHEMA)
+
+static void fill_table(size_t n) {
+    init_table(&g_table, "bench", 4, bench_cols, bench_types);
+    for (size_t i = 0; i < n; ++i) BENCH_CHECK(DS_OK == insert4(&g_table, (int)i + 1, g_times[i], (int)(i % BENCH_DEVICES), (int)(rng_next() % 1000)));
+}
+
+static void delete_fraction(int pct) {
+    size_t deleted = 0;
+    for (size_t i = 0; i < g_table.count; ++i) if ((int)(rng_next() % 100) < pct) { int id = (int)i + 1; size_t d = 0; delete_where_eq(&g_table, "id", &id, &d); deleted += d; }
+    g_sink += (long long)deleted;
+}
+
+static void sink_cb(const Table *t, size_t row, void *user) { (void)t; (void)user; g_sink += (long long)row; }
+
+static void report(const char *name, TsMode mode, int pct, uint64_t ops, uint64_t rows, uint64_t ns) {
+    double ns_per_op = ops ? (double)ns / (double)ops : 0.0;
+    double rows_per_s = ns ? (double)rows * 1e9 / (double)ns : 0.0;
+    printf("{\"config\":\"%s\",\"max_rows\":%d,\"case\":\"%s\",\"ts\":\"%s\",\"delete_ratio\":%.2f,\"ops\":%llu,\"errors\":%llu,\"ns_per_op\":%.2f,\"rows_per_s\":%.0f}\n",
+           DODA_BENCH_CONFIG, MAX_ROWS, name, ts_mode_names[mode], pct / 100.0, (unsigned long long)ops, (unsigned long long)g_errors, ns_per_op, rows_per_s);
+    g_errors_total += g_errors; g_errors = 0;
+}
+
+static void bench_insert(TsMode mode, size_t reps) {
+    uint64_t ns = 0;
+    for (size_t r = 0; r < reps; ++r) { uint64_t t0 = now_ns(); fill_table(MAX_ROWS); ns += now_ns() - t0; }
+    report("insert_fill", mode, 0, (uint64_t)reps * MAX_ROWS, (uint64_t)reps * MAX_ROWS, ns);
+
+    ns = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        uint64_t t0 = now_ns(); sample_init(&g_table, "bench");
+        for (size_t i = 0; i < MAX_ROWS; ++i) { sample_row row = {(int)i + 1, g_times[i], (int)(i % BENCH_DEVICES), (int)(rng_next() % 1000)}; BENCH_CHECK(DS_OK == sample_insert(&g_table, &row)); }
+        ns += now_ns() - t0;
+    }
+    report("typed_insert_fill", mode, 0, (uint64_t)reps * MAX_ROWS, (uint64_t)reps * MAX_ROWS, ns);
+
+    // Column-major batches through insert_rows
+    static int cols[4][MAX_ROWS]; const void *const colp[4] = {cols[0], cols[1], cols[2], cols[3]};
+    for (size_t i = 0; i < MAX_ROWS; ++i) { cols[0][i] = (int)i + 1; cols[1][i] = g_times[i]; cols[2][i] = (int)(i % BENCH_DEVICES); cols[3][i] = (int)(rng_next() % 1000); }
+    ns = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        uint64_t t0 = now_ns(); init_table(&g_table, "bench", 4, bench_cols, bench_types);
+        size_t n = 0; BENCH_CHECK(DS_OK == insert_rows(&g_table, colp, MAX_ROWS, &n)); ns += now_ns() - t0; g_sink += (long long)n;
+    }
+    report("insert_batch", mode, 0, (uint64_t)reps * MAX_ROWS, (uint64_t)reps * MAX_ROWS, ns);
+
+    // Steady-state single-row insert into a full table: delete one row, reuse its slot
+    size_t ops = reps * MAX_ROWS / 4 + 1; int next_id = MAX_ROWS + 1;
+    uint64_t t0 = now_ns();
+    for (size_t i = 0; i < ops; ++i) {
+        int victim = next_id - MAX_ROWS; size_t d = 0;
+        BENCH_CHECK(DS_OK == delete_where_eq(&g_table, "id", &victim, &d) && d == 1);
+        BENCH_CHECK(DS_OK == insert4(&g_table, next_id, next_id * 10, next_id % BENCH_DEVICES, (int)i)); next_id++;
+    }
+    report("insert_reuse", mode, 0, ops, ops, now_ns() - t0);
+}
+
+static void bench_queries(TsMode mode, int pct, size_t reps) {
+    fill_table(MAX_ROWS); delete_fraction(pct);
+    size_t live = agg_count(&g_table);
+    int mid = g_times[MAX_ROWS / 2];
+
+    size_t lookups = reps * MAX_ROWS; uint64_t t0 = now_ns();
+    for (size_t i = 0; i < lookups; ++i) { int id = (int)(rng_next() % MAX_ROWS) + 1; select_where_eq(&g_table, "id", &id, sink_cb, NULL); }
+    report("pk_lookup", mode, pct, lookups, lookups, now_ns() - t0);
+
+    t0 = now_ns();
+    for (size_t i = 0; i < reps; ++i) select_where_op(&g_table, "time", OP_GTE, &mid, sink_cb, NULL);
+    report("range_scan", mode, pct, reps, (uint64_t)reps * g_table.count, now_ns() - t0);
+
+    t0 = now_ns();
+    for (size_t i = 0; i < reps; ++i) sample_select_time(&g_table, OP_GTE, mid, sink_cb, NULL);
+    report("typed_range_scan", mode, pct, reps, (uint64_t)reps * g_table.count, now_ns() - t0);
+
+    t0 = now_ns();
+    for (size_t i = 0; i < reps; ++i) index_build(&g_table, &g_index, "time");
+    report("index_build", mode, pct, reps, (uint64_t)reps * live, now_ns() - t0);
+
+    t0 = now_ns();
+    for (size_t i = 0; i < reps; ++i) index_select_op(&g_table, &g_index, OP_GTE, &mid, sink_cb, NULL);
+    report("range_index", mode, pct, reps, (uint64_t)reps * live / 2, now_ns() - t0);
+
+    double avg = 0.0; t0 = now_ns();
+    for (size_t i = 0; i < reps; ++i) { agg_avg_int(&g_table, "value", &avg); g_sink += (long long)avg; }
+    report("agg_avg", mode, pct, reps, (uint64_t)reps * g_table.count, now_ns() - t0);
+
+    t0 = now_ns();
+    for (size_t i = 0; i < reps; ++i) { agg_group_by(&g_table, "device", "value", NULL, 0, 0, &g_groups); g_sink += (long long)g_groups.size; }
+    report("agg_group_by", mode, pct, reps, (uint64_t)reps * g_table.count, now_ns() - t0);
+}
+
+// In-memory byte stream for the import/export cases
+static struct { char data[MAX_ROWS * 48 + 64]; size_t len, pos; } g_stream;
+static size_t stream_write(void *ctx, const void *buf, size_t len) {
+    (void)ctx; if (len > sizeof(g_stream.data) - g_stream.len) len = sizeof(g_stream.data) - g_stream.len;
+    memcpy(g_stream.data + g_stream.len, buf, len); g_stream.len += len; return len;
+}
+static size_t stream_read(void *ctx, void *buf, size_t len) {
+    (void)ctx; if (len > g_stream.len - g_stream.pos) len = g_stream.len - g_stream.pos;
+    memcpy(buf, g_stream.data + g_stream.pos, len); g_stream.pos += len; return len;
+}
+
+static void bench_io(TsMode mode, size_t reps) {
+    static DodaLoader ld; DodaExporter ex; static Table copy;
+    fill_table(MAX_ROWS);
+    const char *names[2] = {"csv", "bin"};
+    for (int fmt = 0; fmt < 2; ++fmt) {
+        char name[32]; uint64_t ns = 0;
+        for (size_t r = 0; r < reps; ++r) {
+            g_stream.len = 0; doda_export_init(&ex, stream_write, NULL);
+            uint64_t t0 = now_ns();
+            BENCH_CHECK(DodaStatus_OK == (fmt == 0 ? doda_export_csv_table(&ex, &g_table, true) : doda_export_bin_table(&ex, &g_table)));
+            ns += now_ns() - t0;
+        }
+        snprintf(name, sizeof(name), "%s_export", names[fmt]);
+        report(name, mode, 0, (uint64_t)reps * g_table.count, (uint64_t)reps * g_table.count, ns);
+        ns = 0;
+        for (size_t r = 0; r < reps; ++r) {
+            g_stream.pos = 0; init_table(&copy, "copy", 4, bench_cols, bench_types); doda_loader_init(&ld, &copy, stream_read, NULL);
+            uint64_t t0 = now_ns();
+            DodaStatus st = fmt == 0 ? doda_load_csv(&ld, true) : doda_load_bin(&ld);
+            ns += now_ns() - t0; g_sink += (long long)ld.loaded;
+            BENCH_CHECK(st == DodaStatus_OK && ld.rejected == 0 && ld.loaded == g_table.count);
+        }
+        snprintf(name, sizeof(name), "%s_load", names[fmt]);
+        report(name, mode, 0, (uint64_t)reps * g_table.count, (uint64_t)reps * g_table.count, ns);
+    }
+}
+
+// Alarm filter: alarm AND NOT ack AND status IN (2,3), as row-by-row scan vs bitmap words
+static const char *alarm_cols[] = {"id", "alarm", "ack", "status"};
+static const ColumnType alarm_types[] = {COL_INT, COL_BOOL, COL_BOOL, COL_INT};
+static void alarm_filter_cb(const Table *t, size_t row, void *user) {
+    int s = t->columns[3].data.int_data[row];
+    if (column_bool_get(&t->columns[1], row) && !column_bool_get(&t->columns[2], row) && (s == 2 || s == 3)) ++*(size_t *)user;
+}
+
+static void bench_bitmap(TsMode mode, int pct, size_t reps) {
+    init_table(&g_table, "alarms", 4, alarm_cols, alarm_types);
+    for (size_t i = 0; i < MAX_ROWS; ++i) {
+        int id = (int)i + 1, alarm = (int)(rng_next() % 4 == 0), ack = (int)(rng_next() % 2), status = (int)(rng_next() % 6);
+        const void *vals[4] = {&id, &alarm, &ack, &status}; BENCH_CHECK(DS_OK == insert_row(&g_table, vals));
+    }
+    delete_fraction(pct);
+    static BitmapIndex bm; const int wanted[] = {2, 3}; RowSet hits, acked, in_status;
+    uint64_t t0 = now_ns();
+    for (size_t r = 0; r < reps; ++r) BENCH_CHECK(DS_OK == bitmap_index_build(&g_table, &bm, "status"));
+    report("bitmap_build", mode, pct, reps, (uint64_t)reps * g_table.count, now_ns() - t0);
+    t0 = now_ns();
+    for (size_t r = 0; r < reps; ++r) { size_t n = 0; int one = 1; select_where_eq(&g_table, "alarm", &one, alarm_filter_cb, &n); g_sink += (long long)n; }
+    report("alarm_filter_scan", mode, pct, reps, (uint64_t)reps * g_table.count, now_ns() - t0);
+    t0 = now_ns();
+    for (size_t r = 0; r < reps; ++r) {
+        rowset_from_bool(&g_table, "alarm", true, &hits); rowset_from_bool(&g_table, "ack", true, &acked);
+        rowset_from_bitmap_in(&g_table, &bm, wanted, 2, &in_status);
+        rowset_andnot(&hits, &acked); rowset_and(&hits, &in_status); g_sink += (long long)rowset_count(&g_table, &hits);
+    }
+    report("alarm_filter_bitmap", mode, pct, reps, (uint64_t)reps * g_table.count, now_ns() - t0);
+}
+
+static void bench_retention(TsMode mode, int pct, size_t reps) {
+    DodaTSDB ts; uint64_t ns = 0, deleted = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        fill_table(MAX_ROWS); delete_fraction(pct); doda_tsdb_init(&ts, &g_table, "time");
+        size_t d = 0; uint64_t t0 = now_ns(); doda_tsdb_delete_older_than(&ts, g_times[MAX_ROWS / 4], &d); ns += now_ns() - t0; deleted += d;
+    }
+    report("retention_delete", mode, pct, reps, deleted, ns);
+}
+
+int main(void) {
+    size_t reps = BENCH_ROW_BUDGET / MAX_ROWS; if (reps == 0) reps = 1;
+    for (int m = 0; m < TS_MODE_COUNT; ++m) {
+        rng_seed(0xD0DAu + (uint32_t)m); gen_times((TsMode)m, MAX_ROWS);
+        bench_insert((TsMode)m, reps);
+        bench_io((TsMode)m, reps);
+        for (size_t d = 0; d < DELETE_RATIO_COUNT; ++d) {
+            bench_queries((TsMode)m, delete_pct[d], reps);
+            bench_retention((TsMode)m, delete_pct[d], reps);
+            bench_bitmap((TsMode)m, delete_pct[d], reps);
+        }
+    }
+    if (g_errors_total) { fprintf(stderr, "doda_bench: %llu failed operations\n", (unsigned long long)g_errors_total); return 1; }
+    return 0;
+}
@@ -15,9 +15,39 @@
 // Timeseries convenience API built on core without changing core logic
 // Assumes a schema with primary key 'id' (int) and a timestamp column 'time' (int)
 
+#ifndef DRIVERSQL_WINDOW_MAX
+#define DRIVERSQL_WINDOW_MAX 64
+#endif
+#ifndef DRIVERSQL_TS_MAX_WINDOWS
+#define DRIVERSQL_TS_MAX_WINDOWS 4
+#endif
+#if (DRIVERSQL_WINDOW_MAX & (DRIVERSQL_WINDOW_MAX - 1)) != 0
+#error "DRIVERSQL_WINDOW_MAX must be a power of two"
+#endif
+
+typedef enum { DODA_WIN_COUNT = 0, DODA_WIN_TIME } DodaWindowKind;
+
+// Incremental sliding window over an INT column. Samples are kept in arrival order in a ring
+// addressed by sequence number; min/max use monotonic deques so every push/evict is O(1) amortized.
+typedef struct {
+    DodaWindowKind kind;
+    int size;   // last `size` samples (COUNT) or samples with time > newest - size (TIME)
+    int col;    // bound column when attached to a DodaTSDB, -1 otherwise
+    int times[DRIVERSQL_WINDOW_MAX];
+    int values[DRIVERSQL_WINDOW_MAX];
+    uint32_t head, tail; // oldest sample / one past newest
+    long long sum;
+    uint32_t min_q[DRIVERSQL_WINDOW_MAX], max_q[DRIVERSQL_WINDOW_MAX];
+    uint32_t min_head, min_tail, max_head, max_tail;
+    double alpha, ewma; // alpha <= 0 disables EWMA; covers every pushed sample, not just the window
+    bool ewma_valid;
+} DodaWindow;
+
 typedef struct {
     DodaTable *table;
     const char *time_col; // e.g., "time"
+    DodaWindow *windows[DRIVERSQL_TS_MAX_WINDOWS];
+    size_t window_count;
 } DodaTSDB;
 
 void doda_tsdb_init(DodaTSDB *ts, DodaTable *t, const char *time_col);
@@ -36,6 +66,45 @@ bool doda_tsdb_build_time_index(DodaTSDB *ts, DodaIndex *idx);
 // Delete samples older than cutoff time
 DodaStatus doda_tsdb_delete_older_than(DodaTSDB *ts, int cutoff_time, size_t *deleted_out);
 
+// As-of join: for each left row (in time order) emit the latest right row with time <= left time.
+// rrow is DODA_NO_ROW when no such row exists or it is older than tolerance (tolerance < 0 = unlimited).
+// Each side is walked through its Index on the time column, or in physical order when the index is NULL
+// (physical times must then be non-decreasing, otherwise DodaStatus_ERR_INVALID). O(N + M).
+#define DODA_NO_ROW ((size_t)-1)
+typedef void (*doda_asof_callback)(const DodaTable *left, size_t lrow, const DodaTable *right, size_t rrow, void *user);
+DodaStatus doda_tsdb_asof_join(const DodaTSDB *left, const DodaIndex *lidx, const DodaTSDB *right, const DodaIndex *ridx, int tolerance, doda_asof_callback cb, void *user);
+
+// Linear-interpolation variant: emit right.value_col interpolated at each left time.
+// Left rows outside the right time range are skipped.
+typedef void (*doda_interp_callback)(const DodaTable *left, size_t lrow, double value, void *user);
+DodaStatus doda_tsdb_asof_interp(const DodaTSDB *left, const DodaIndex *lidx, const DodaTSDB *right, const DodaIndex *ridx, const char *value_col, doda_interp_callback cb, void *user);
+
+// Sliding windows. A TIME window is also capped at DRIVERSQL_WINDOW_MAX samples.
+// Init returns DodaStatus_ERR_INVALID (window left uninitialized) for size <= 0 or a COUNT size
+// above DRIVERSQL_WINDOW_MAX.
+// EWMA is not a windowed statistic: it decays over every sample ever pushed and eviction does not
+// touch it, so its history is unbounded (weight of a sample n pushes ago is alpha * (1 - alpha)^n).
+DodaStatus doda_window_init(DodaWindow *w, DodaWindowKind kind, int size, double ewma_alpha);
+void doda_window_push(DodaWindow *w, int time, int value);
+// Drop samples with time < cutoff (oldest first; assumes non-decreasing append times)
+void doda_window_evict_before(DodaWindow *w, int cutoff);
+size_t doda_window_count(const DodaWindow *w);
+bool doda_window_sum(const DodaWindow *w, long long *out);
+bool doda_window_avg(const DodaWindow *w, double *out);
+bool doda_window_min(const DodaWindow *w, int *out);
+bool doda_window_max(const DodaWindow *w, int *out);
+bool doda_window_delta(const DodaWindow *w, int *out);   // newest - oldest value
+bool doda_window_rate(const DodaWindow *w, double *out); // delta / (newest - oldest time)
+bool doda_window_ewma(const DodaWindow *w, double *out);
+
+// Bind a window to a column; it is then fed by doda_tsdb_append_int3 and trimmed by doda_tsdb_delete_older_than.
+// Only columns 0..2 can be attached (DodaStatus_ERR_UNSUPPORTED otherwise): append_int3 is the only
+// append path and supplies exactly three values. Windows mirror appends, not table contents: only
+// delete_older_than evicts, so rows removed with doda_delete_where_eq stay in the window until they
+// age out or are evicted by a later delete_older_than.
+// Returns DodaStatus_ERR_FULL when DRIVERSQL_TS_MAX_WINDOWS windows are already attached.
+DodaStatus doda_tsdb_attach_window(DodaTSDB *ts, DodaWindow *w, const char *col_name);
+
 // Aggregations over non-deleted rows for numeric columns
 bool agg_min_int(const Table *t, const char *col_name, int *out);
 bool agg_max_int(const Table *t, const char *col_name, int *out);
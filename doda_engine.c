@@ -13,12 +13,59 @@
 #include <stdio.h>
 #endif
 
+#ifdef DRIVERSQL_STATS
+static EngineStats g_stats;
+static stats_clock_fn g_stats_clock;
+
+typedef struct { row_callback cb; void *user; uint64_t matched; } StatCb;
+static void stat_count_cb(const Table *t, size_t row, void *user) { StatCb *s = (StatCb *)user; s->matched++; s->cb(t, row, s->user); }
+
+static void stat_record(StatOp op, uint64_t t0) {
+    if (!g_stats_clock) return;
+    uint64_t dt = g_stats_clock() - t0; LatencyHist *h = &g_stats.latency[op];
+    unsigned b = 0; while ((dt >> (b + 1)) != 0 && b + 1 < DRIVERSQL_STATS_BUCKETS) b++;
+    h->calls++; h->total_ticks += dt; if (dt > h->max_ticks) h->max_ticks = dt; h->buckets[b]++;
+}
+
+static inline void stat_probe(uint64_t steps) {
+    g_stats.pk_probes++; g_stats.pk_probe_steps += steps; if (steps > g_stats.pk_probe_max) g_stats.pk_probe_max = steps;
+}
+
+void stats_set_clock(stats_clock_fn clock) { g_stats_clock = clock; }
+void stats_snapshot(EngineStats *out) { if (out) *out = g_stats; }
+void stats_reset(void) { memset(&g_stats, 0, sizeof(g_stats)); }
+
+#define STAT_ADD(field, n) (g_stats.field += (uint64_t)(n))
+#define STAT_PROBE(steps) stat_probe((uint64_t)(steps))
+#define STAT_BEGIN() uint64_t stat_t0_ = g_stats_clock ? g_stats_clock() : 0
+#define STAT_END(op) stat_record((op), stat_t0_)
+#define STAT_WRAP_CB(cb, user) StatCb stat_cb_ = { (cb), (user), 0 }; if (cb) { (cb) = stat_count_cb; (user) = &stat_cb_; }
+#define STAT_UNWRAP_CB() (g_stats.rows_matched += stat_cb_.matched)
+#else
+#define STAT_ADD(field, n) ((void)0)
+#define STAT_PROBE(steps) ((void)0)
+#define STAT_BEGIN() ((void)0)
+#define STAT_END(op) ((void)0)
+#define STAT_WRAP_CB(cb, user) ((void)0)
+#define STAT_UNWRAP_CB() ((void)0)
+#endif
+
 static inline void set_deleted_bit(Table *t, size_t row, bool del) {
     size_t block = row / 64, bit = row % 64;
     uint64_t mask = 1ULL << bit;
     if (del) t->deleted_bits[block] |= mask; else t->deleted_bits[block] &= ~mask;
 }
 
+// Live rows of 64-row word w: not deleted and below t->count
+static inline uint64_t live_word(const Table *t, size_t w) {
+    uint64_t live = ~t->deleted_bits[w]; size_t lim = t->count - w * 64;
+    return lim < 64 ? live & ((1ULL << lim) - 1) : live;
+}
+
+static inline size_t emit_word(const Table *t, size_t w, uint64_t m, row_callback cb, void *user) {
+    size_t n = 0; while (m) { size_t r = w * 64 + DODA_CTZ64(m); m &= m - 1; if (cb) cb(t, r, user); n++; } return n;
+}
+
 bool is_deleted(const Table *t, size_t row) {
     size_t block = row / 64, bit = row % 64;
     return (t->deleted_bits[block] >> bit) & 1ULL;
@@ -35,9 +82,9 @@ static bool pk_hash_insert(Table *t, int key, uint16_t row) {
     for (uint32_t i = 0; i < HASH_SIZE; ++i) {
         uint32_t idx = (h + i) & (HASH_SIZE - 1);
         uint16_t slot = t->pk_hash[idx];
-        if (slot == 0) { t->pk_hash[idx] = (uint16_t)(row + 1); return true; }
+        if (slot == 0) { t->pk_hash[idx] = (uint16_t)(row + 1); STAT_PROBE(i + 1); return true; }
         uint16_t srow = (uint16_t)(slot - 1);
-        if (!is_deleted(t, srow) && t->columns[0].data.int_data[srow] == key) return false;
+        if (!is_deleted(t, srow) && t->columns[0].data.int_data[srow] == key) { STAT_PROBE(i + 1); return false; }
     }
     return false;
 }
@@ -47,22 +94,29 @@ static int pk_hash_find(const Table *t, int key) {
     for (uint32_t i = 0; i < HASH_SIZE; ++i) {
         uint32_t idx = (h + i) & (HASH_SIZE - 1);
         uint16_t slot = t->pk_hash[idx];
-        if (slot == 0) return -1;
+        if (slot == 0) { STAT_PROBE(i + 1); return -1; }
         uint16_t row = (uint16_t)(slot - 1);
-        if (!is_deleted(t, row) && t->columns[0].data.int_data[row] == key) return (int)row;
+        if (!is_deleted(t, row) && t->columns[0].data.int_data[row] == key) { STAT_PROBE(i + 1); return (int)row; }
     }
     return -1;
 }
 
-static void pk_hash_remove(Table *t, int key) {
-    uint32_t h = hash32((uint32_t)key);
-    for (uint32_t i = 0; i < HASH_SIZE; ++i) {
-        uint32_t idx = (h + i) & (HASH_SIZE - 1);
-        uint16_t slot = t->pk_hash[idx];
-        if (slot == 0) return;
-        uint16_t row = (uint16_t)(slot - 1);
-        if (!is_deleted(t, row) && t->columns[0].data.int_data[row] == key) { t->pk_hash[idx] = 0; return; }
+// Linear-probing delete by backward shift: after emptying a slot, later entries of the run whose home
+// slot does not lie cyclically in (hole, j] move into the hole, so no probe chain is cut and no
+// tombstones are left behind.
+static void pk_hash_remove(Table *t, size_t row) {
+    uint32_t mask = HASH_SIZE - 1, idx = hash32((uint32_t)t->columns[0].data.int_data[row]) & mask, i = 0;
+    while (t->pk_hash[idx] != row + 1) { if (t->pk_hash[idx] == 0 || ++i == HASH_SIZE) return; idx = (idx + 1) & mask; }
+    uint32_t hole = idx;
+    for (uint32_t j = (hole + 1) & mask, n = 1; n < HASH_SIZE && t->pk_hash[j] != 0; j = (j + 1) & mask, ++n) {
+        uint32_t home = hash32((uint32_t)t->columns[0].data.int_data[t->pk_hash[j] - 1]) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) { t->pk_hash[hole] = t->pk_hash[j]; hole = j; }
     }
+    t->pk_hash[hole] = 0;
+}
+
+void table_delete_row(Table *t, size_t row) {
+    pk_hash_remove(t, row); set_deleted_bit(t, row, true); t->free_list[t->free_top++] = (uint16_t)row;
 }
 
 // Firmware-safe initializer: caller supplies Table storage
@@ -107,15 +161,27 @@ static inline bool type_enabled(ColumnType ct) {
     }
 }
 
-DSStatus insert_row(Table *t, const void *values[]) {
+DSStatus table_reserve_row(Table *t, size_t *row_out) {
+    if (t->count >= t->capacity && t->free_top == 0) return DS_ERR_FULL;
+    if (t->count >= t->capacity) { *row_out = t->free_list[--t->free_top]; STAT_ADD(free_list_reuse, 1); }
+    else { *row_out = t->count++; }
+    return DS_OK;
+}
+
+DSStatus table_commit_row(Table *t, size_t row) {
+    set_deleted_bit(t, row, false);
+    int pk = t->columns[0].data.int_data[row];
+    if (!pk_hash_insert(t, pk, (uint16_t)row)) { set_deleted_bit(t, row, true); t->free_list[t->free_top++] = (uint16_t)row; return DS_ERR_UNSUPPORTED; } // duplicate PK
+    t->generation++;
+    return DS_OK;
+}
+
+static DSStatus insert_row_impl(Table *t, const void *values[]) {
     if (!t || !values) return DS_ERR_INVALID;
     // Validate types against feature gates
     for (int i = 0; i < t->column_count; ++i) if (!type_enabled(t->columns[i].type)) return DS_ERR_UNSUPPORTED;
 
-    size_t row;
-    if (t->count >= t->capacity && t->free_top == 0) return DS_ERR_FULL;
-    if (t->count >= t->capacity) { row = t->free_list[--t->free_top]; }
-    else { row = t->count++; }
+    size_t row; DSStatus st = table_reserve_row(t, &row); if (st != DS_OK) return st;
 
     for (int i = 0; i < t->column_count; ++i) {
         Column *c = &t->columns[i];
@@ -124,7 +190,7 @@ DSStatus insert_row(Table *t, const void *values[]) {
 #ifndef DRIVERSQL_NO_TEXT
             case COL_TEXT:   { const char *s = (const char *)values[i]; strncpy(c->data.text_data[row], s ? s : "", MAX_TEXT_LEN - 1); c->data.text_data[row][MAX_TEXT_LEN - 1] = '\0'; break; }
 #endif
-            case COL_BOOL:   c->data.bool_data[row] = values[i] ? (uint8_t)(*(const int *)values[i] != 0) : 0; break;
+            case COL_BOOL:   column_bool_set(c, row, values[i] && *(const int *)values[i] != 0); break;
 #ifndef DRIVERSQL_NO_FLOAT
             case COL_FLOAT:  c->data.float_data[row] = *(const float *)values[i]; break;
 #endif
@@ -137,21 +203,79 @@ DSStatus insert_row(Table *t, const void *values[]) {
             default: return DS_ERR_UNSUPPORTED;
         }
     }
-    set_deleted_bit(t, row, false);
-    int pk = t->columns[0].data.int_data[row];
-    if (!pk_hash_insert(t, pk, (uint16_t)row)) return DS_ERR_UNSUPPORTED; // duplicate PK
-    return DS_OK;
+    return table_commit_row(t, row);
+}
+
+DSStatus insert_row(Table *t, const void *values[]) {
+    STAT_BEGIN(); DSStatus res = insert_row_impl(t, values); STAT_END(STAT_INSERT_ROW); return res;
+}
+
+// Store element i of a columnar input array (layout documented at insert_rows) into row
+static void store_columnar(Column *c, size_t row, const void *col, size_t i) {
+    switch (c->type) {
+        case COL_INT:    c->data.int_data[row] = ((const int *)col)[i]; break;
+#ifndef DRIVERSQL_NO_TEXT
+        case COL_TEXT:   { const char *s = ((const char (*)[MAX_TEXT_LEN])col)[i]; strncpy(c->data.text_data[row], s, MAX_TEXT_LEN - 1); c->data.text_data[row][MAX_TEXT_LEN - 1] = '\0'; break; }
+#endif
+        case COL_BOOL:   column_bool_set(c, row, ((const int *)col)[i] != 0); break;
+#ifndef DRIVERSQL_NO_FLOAT
+        case COL_FLOAT:  c->data.float_data[row] = ((const float *)col)[i]; break;
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+        case COL_DOUBLE: c->data.double_data[row] = ((const double *)col)[i]; break;
+#endif
+#ifndef DRIVERSQL_NO_POINTER_COLUMN
+        case COL_POINTER:c->data.ptr_data[row] = ((void *const *)col)[i]; break;
+#endif
+        default: break;
+    }
+}
+
+static DSStatus insert_rows_impl(Table *t, const void *const columns[], size_t n, size_t *inserted_out) {
+    if (!t || !columns || !inserted_out) return DS_ERR_INVALID;
+    *inserted_out = 0;
+    for (int i = 0; i < t->column_count; ++i) if (!type_enabled(t->columns[i].type)) return DS_ERR_UNSUPPORTED;
+    bool dup = false;
+    // Untouched tail: one block copy per fixed-width column, then bulk-load the PK hash
+    size_t first = t->count, k = t->capacity - t->count; if (k > n) k = n;
+    if (k) {
+        for (int i = 0; i < t->column_count; ++i) {
+            Column *c = &t->columns[i];
+            if (c->type == COL_INT) memcpy(&c->data.int_data[first], columns[i], k * sizeof(int));
+#ifndef DRIVERSQL_NO_FLOAT
+            else if (c->type == COL_FLOAT) memcpy(&c->data.float_data[first], columns[i], k * sizeof(float));
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+            else if (c->type == COL_DOUBLE) memcpy(&c->data.double_data[first], columns[i], k * sizeof(double));
+#endif
+            else for (size_t j = 0; j < k; ++j) store_columnar(c, first + j, columns[i], j);
+        }
+        t->count += k;
+        for (size_t j = 0; j < k; ++j) { if (table_commit_row(t, first + j) == DS_OK) (*inserted_out)++; else dup = true; }
+    }
+    // Remaining rows reuse deleted slots one at a time
+    for (size_t j = k; j < n; ++j) {
+        size_t row; if (table_reserve_row(t, &row) != DS_OK) return DS_ERR_FULL;
+        for (int i = 0; i < t->column_count; ++i) store_columnar(&t->columns[i], row, columns[i], j);
+        if (table_commit_row(t, row) == DS_OK) (*inserted_out)++; else dup = true;
+    }
+    return dup ? DS_ERR_UNSUPPORTED : DS_OK;
+}
+
+DSStatus insert_rows(Table *t, const void *const columns[], size_t n, size_t *inserted_out) {
+    STAT_BEGIN(); DSStatus res = insert_rows_impl(t, columns, n, inserted_out); STAT_END(STAT_INSERT_ROWS); return res;
 }
 
 DSStatus insert_row_int_text_int(Table *t, int v0, const char *v1, int v2) {
     const void *vals[3]; vals[0] = &v0; vals[1] = v1; vals[2] = &v2; return insert_row(t, vals);
 }
 
-DSStatus select_where_eq(const Table *t, const char *col_name, const void *eq_value, row_callback cb, void *user) {
+static DSStatus select_where_eq_impl(const Table *t, const char *col_name, const void *eq_value, row_callback cb, void *user) {
     if (!t || !col_name || !cb) return DS_ERR_INVALID;
     int idx = column_index(t, col_name); if (idx < 0) return DS_ERR_NOT_FOUND; const Column *c = &t->columns[idx];
     if (!type_enabled(c->type)) return DS_ERR_UNSUPPORTED;
-    if (idx == 0 && c->type == COL_INT) { int key = *(const int *)eq_value; int row = pk_hash_find(t, key); if (row >= 0) cb(t, (size_t)row, user); return DS_OK; }
+    if (idx == 0 && c->type == COL_INT) { int key = *(const int *)eq_value; int row = pk_hash_find(t, key); STAT_ADD(rows_scanned, row >= 0); if (row >= 0) cb(t, (size_t)row, user); return DS_OK; }
+    STAT_ADD(rows_scanned, t->count);
     switch (c->type) {
         case COL_INT: {
             int key = *(const int *)eq_value;
@@ -166,8 +290,8 @@ DSStatus select_where_eq(const Table *t, const char *col_name, const void *eq_va
         }
 #endif
         case COL_BOOL: {
-            uint8_t key = (uint8_t)(*(const int *)eq_value != 0);
-            for (size_t r = 0; r < t->count; ++r) if (!is_deleted(t, r) && t->columns[idx].data.bool_data[r] == key) cb(t, r, user);
+            bool key = *(const int *)eq_value != 0;
+            for (size_t w = 0; w * 64 < t->count; ++w) emit_word(t, w, bool_match_word(c->data.bool_bits[w], OP_EQ, key) & live_word(t, w), cb, user);
             break;
         }
 #ifndef DRIVERSQL_NO_FLOAT
@@ -195,12 +319,16 @@ DSStatus select_where_eq(const Table *t, const char *col_name, const void *eq_va
     return DS_OK;
 }
 
-DSStatus select_where_op(const Table *t, const char *col_name, Op op, const void *value, row_callback cb, void *user) {
+DSStatus select_where_eq(const Table *t, const char *col_name, const void *eq_value, row_callback cb, void *user) {
+    STAT_BEGIN(); STAT_WRAP_CB(cb, user); DSStatus res = select_where_eq_impl(t, col_name, eq_value, cb, user); STAT_UNWRAP_CB(); STAT_END(STAT_SELECT_WHERE_EQ); return res;
+}
+
+static DSStatus select_where_op_impl(const Table *t, const char *col_name, Op op, const void *value, row_callback cb, void *user) {
     if (!t || !col_name || !cb) return DS_ERR_INVALID;
     int idx = column_index(t, col_name); if (idx < 0) return DS_ERR_NOT_FOUND; const Column *c = &t->columns[idx];
     if (!type_enabled(c->type)) return DS_ERR_UNSUPPORTED;
     if (c->type == COL_INT) {
-        int key = *(const int *)value;
+        int key = *(const int *)value; STAT_ADD(rows_scanned, t->count);
         for (size_t r = 0; r < t->count; ++r) {
             if (is_deleted(t, r)) continue; int v = c->data.int_data[r]; bool m = false;
             switch (op) { case OP_EQ: m = (v == key); break; case OP_GT: m = (v > key); break; case OP_LT: m = (v < key); break; case OP_GTE: m = (v >= key); break; }
@@ -209,7 +337,7 @@ DSStatus select_where_op(const Table *t, const char *col_name, Op op, const void
     }
 #ifndef DRIVERSQL_NO_FLOAT
     else if (c->type == COL_FLOAT) {
-        float key = *(const float *)value;
+        float key = *(const float *)value; STAT_ADD(rows_scanned, t->count);
         for (size_t r = 0; r < t->count; ++r) {
             if (is_deleted(t, r)) continue; float v = t->columns[idx].data.float_data[r]; bool m = false;
             switch (op) { case OP_EQ: m = (v == key); break; case OP_GT: m = (v > key); break; case OP_LT: m = (v < key); break; case OP_GTE: m = (v >= key); break; }
@@ -219,7 +347,7 @@ DSStatus select_where_op(const Table *t, const char *col_name, Op op, const void
 #endif
 #ifndef DRIVERSQL_NO_DOUBLE
     else if (c->type == COL_DOUBLE) {
-        double key = *(const double *)value;
+        double key = *(const double *)value; STAT_ADD(rows_scanned, t->count);
         for (size_t r = 0; r < t->count; ++r) {
             if (is_deleted(t, r)) continue; double v = t->columns[idx].data.double_data[r]; bool m = false;
             switch (op) { case OP_EQ: m = (v == key); break; case OP_GT: m = (v > key); break; case OP_LT: m = (v < key); break; case OP_GTE: m = (v >= key); break; }
@@ -227,14 +355,18 @@ DSStatus select_where_op(const Table *t, const char *col_name, Op op, const void
         }
     }
 #endif
-#ifndef DRIVERSQL_NO_TEXT
-    else { if (op == OP_EQ) select_where_eq(t, col_name, value, cb, user); }
-#else
-    else { if (op == OP_EQ && c->type == COL_BOOL) select_where_eq(t, col_name, value, cb, user); }
-#endif
+    else if (c->type == COL_BOOL) {
+        bool key = *(const int *)value != 0; STAT_ADD(rows_scanned, t->count);
+        for (size_t w = 0; w * 64 < t->count; ++w) emit_word(t, w, bool_match_word(c->data.bool_bits[w], op, key) & live_word(t, w), cb, user);
+    }
+    else { if (op == OP_EQ) select_where_eq_impl(t, col_name, value, cb, user); }
     return DS_OK;
 }
 
+DSStatus select_where_op(const Table *t, const char *col_name, Op op, const void *value, row_callback cb, void *user) {
+    STAT_BEGIN(); STAT_WRAP_CB(cb, user); DSStatus res = select_where_op_impl(t, col_name, op, value, cb, user); STAT_UNWRAP_CB(); STAT_END(STAT_SELECT_WHERE_OP); return res;
+}
+
 DSStatus delete_where_eq(Table *t, const char *col_name, const void *eq_value, size_t *deleted_out) {
     if (!t || !col_name || !deleted_out) return DS_ERR_INVALID; *deleted_out = 0;
     int idx = column_index(t, col_name); if (idx < 0) return DS_ERR_NOT_FOUND; Column *c = &t->columns[idx];
@@ -244,19 +376,26 @@ DSStatus delete_where_eq(Table *t, const char *col_name, const void *eq_value, s
         int key = *(const int *)eq_value;
         if (idx == 0) {
             int row = pk_hash_find(t, key);
-            if (row >= 0 && !is_deleted(t, (size_t)row)) { set_deleted_bit(t, (size_t)row, true); pk_hash_remove(t, key); t->free_list[t->free_top++] = (uint16_t)row; del = 1; }
+            if (row >= 0 && !is_deleted(t, (size_t)row)) { table_delete_row(t, (size_t)row); del = 1; }
             *deleted_out = del;
             return DS_OK;
         }
         for (size_t r = 0; r < t->count; ++r) {
-            if (is_deleted(t, r)) continue; if (c->data.int_data[r] == key) { set_deleted_bit(t, r, true); t->free_list[t->free_top++] = (uint16_t)r; del++; }
+            if (is_deleted(t, r)) continue; if (c->data.int_data[r] == key) { table_delete_row(t, r); del++; }
+        }
+    }
+    else if (c->type == COL_BOOL) {
+        bool key = *(const int *)eq_value != 0;
+        for (size_t w = 0; w * 64 < t->count; ++w) {
+            uint64_t m = bool_match_word(c->data.bool_bits[w], OP_EQ, key) & live_word(t, w);
+            while (m) { table_delete_row(t, w * 64 + DODA_CTZ64(m)); m &= m - 1; del++; }
         }
     }
 #ifndef DRIVERSQL_NO_TEXT
     else {
         const char *key = (const char *)eq_value;
         for (size_t r = 0; r < t->count; ++r) {
-            if (is_deleted(t, r)) continue; if (strncmp(c->data.text_data[r], key, MAX_TEXT_LEN) == 0) { set_deleted_bit(t, r, true); t->free_list[t->free_top++] = (uint16_t)r; del++; }
+            if (is_deleted(t, r)) continue; if (strncmp(c->data.text_data[r], key, MAX_TEXT_LEN) == 0) { table_delete_row(t, r); del++; }
         }
     }
 #else
@@ -276,7 +415,7 @@ void print_row(const Table *t, size_t r) {
 #ifndef DRIVERSQL_NO_TEXT
         else if (c->type == COL_TEXT) printf("%s", c->data.text_data[r]);
 #endif
-        else if (c->type == COL_BOOL) printf("%s", t->columns[i].data.bool_data[r] ? "true" : "false");
+        else if (c->type == COL_BOOL) printf("%s", column_bool_get(c, r) ? "true" : "false");
 #ifndef DRIVERSQL_NO_FLOAT
         else if (c->type == COL_FLOAT) printf("%g", t->columns[i].data.float_data[r]);
 #endif
@@ -341,7 +480,7 @@ static void sort_rows_by_text(const Table *t, int col, uint16_t *rows, size_t n)
 }
 #endif
 
-bool index_build(Table *t, Index *idx, const char *col_name) {
+static bool index_build_impl(Table *t, Index *idx, const char *col_name) {
     int col = column_index(t, col_name); if (col < 0) { idx->active = false; return false; }
     idx->column_id = col; idx->size = 0; idx->active = true;
     for (size_t r = 0; r < t->count; ++r) if (!is_deleted(t, r)) idx->rows[idx->size++] = (uint16_t)r;
@@ -361,62 +500,144 @@ bool index_build(Table *t, Index *idx, const char *col_name) {
     return true;
 }
 
+bool index_build(Table *t, Index *idx, const char *col_name) {
+    STAT_BEGIN(); bool res = index_build_impl(t, idx, col_name); STAT_END(STAT_INDEX_BUILD); return res;
+}
+
 void index_drop(Index *idx) { idx->active = false; idx->size = 0; idx->column_id = -1; }
 
-static ssize_t idx_lower_bound_int(const Table *t, int col, const Index *idx, int key) {
-    size_t lo = 0, hi = idx->size; while (lo < hi) { size_t mid = (lo + hi) >> 1; int v = t->columns[col].data.int_data[idx->rows[mid]]; if (v < key) lo = mid + 1; else hi = mid; } return (ssize_t)lo;
+static DSStatus bitmap_index_build_impl(const Table *t, BitmapIndex *bm, const char *col_name) {
+    if (!t || !bm || !col_name) return DS_ERR_INVALID;
+    bitmap_index_drop(bm);
+    int col = column_index(t, col_name); if (col < 0) return DS_ERR_NOT_FOUND;
+    if (t->columns[col].type != COL_INT) return DS_ERR_UNSUPPORTED;
+    const int *data = t->columns[col].data.int_data; STAT_ADD(rows_scanned, t->count);
+    for (size_t r = 0; r < t->count; ++r) {
+        if (is_deleted(t, r)) continue;
+        size_t v = 0; while (v < bm->value_count && bm->values[v] != data[r]) v++;
+        if (v == bm->value_count) {
+            if (v == DRIVERSQL_BITMAP_MAX_VALUES) { bitmap_index_drop(bm); return DS_ERR_FULL; }
+            bm->values[v] = data[r]; memset(bm->bits[v], 0, sizeof(bm->bits[v])); bm->value_count++;
+        }
+        bm->bits[v][r / 64] |= 1ULL << (r % 64);
+    }
+    bm->column_id = col; bm->generation = t->generation; bm->active = true;
+    return DS_OK;
+}
+
+DSStatus bitmap_index_build(const Table *t, BitmapIndex *bm, const char *col_name) {
+    STAT_BEGIN(); DSStatus res = bitmap_index_build_impl(t, bm, col_name); STAT_END(STAT_INDEX_BUILD); return res;
+}
+
+DSStatus bitmap_index_refresh(const Table *t, BitmapIndex *bm) {
+    if (!t || !bm) return DS_ERR_INVALID;
+    if (!bm->active || bm->column_id >= t->column_count) return DS_ERR_NOT_FOUND;
+    if (bm->generation == t->generation) return DS_OK;
+    return bitmap_index_build(t, bm, t->columns[bm->column_id].name);
+}
+
+void bitmap_index_drop(BitmapIndex *bm) { bm->active = false; bm->value_count = 0; bm->column_id = -1; }
+
+void rowset_all(const Table *t, RowSet *out) {
+    size_t words = (t->count + 63) / 64;
+    for (size_t w = 0; w < words; ++w) out->bits[w] = live_word(t, w);
+    for (size_t w = words; w < ROW_WORDS; ++w) out->bits[w] = 0;
+}
+
+DSStatus rowset_from_bool(const Table *t, const char *col_name, bool value, RowSet *out) {
+    if (!t || !col_name || !out) return DS_ERR_INVALID;
+    int col = column_index(t, col_name); if (col < 0) return DS_ERR_NOT_FOUND;
+    if (t->columns[col].type != COL_BOOL) return DS_ERR_UNSUPPORTED;
+    rowset_all(t, out);
+    for (size_t w = 0; w < ROW_WORDS; ++w) out->bits[w] &= bool_match_word(t->columns[col].data.bool_bits[w], OP_EQ, value);
+    return DS_OK;
+}
+
+DSStatus rowset_from_bitmap_in(const Table *t, const BitmapIndex *bm, const int *values, size_t n, RowSet *out) {
+    if (!t || !bm || !out || (n && !values)) return DS_ERR_INVALID;
+    if (!bm->active) return DS_ERR_NOT_FOUND;
+    if (bm->generation != t->generation) return DS_ERR_INVALID; // stale: see bitmap_index_refresh
+    memset(out->bits, 0, sizeof(out->bits));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t v = 0; v < bm->value_count; ++v)
+            if (bm->values[v] == values[i]) { for (size_t w = 0; w < ROW_WORDS; ++w) out->bits[w] |= bm->bits[v][w]; break; }
+    RowSet live; rowset_all(t, &live); rowset_and(out, &live);
+    return DS_OK;
+}
+
+DSStatus rowset_from_bitmap_eq(const Table *t, const BitmapIndex *bm, int value, RowSet *out) { return rowset_from_bitmap_in(t, bm, &value, 1, out); }
+
+void rowset_and(RowSet *dst, const RowSet *src) { for (size_t w = 0; w < ROW_WORDS; ++w) dst->bits[w] &= src->bits[w]; }
+void rowset_or(RowSet *dst, const RowSet *src) { for (size_t w = 0; w < ROW_WORDS; ++w) dst->bits[w] |= src->bits[w]; }
+void rowset_andnot(RowSet *dst, const RowSet *src) { for (size_t w = 0; w < ROW_WORDS; ++w) dst->bits[w] &= ~src->bits[w]; }
+
+size_t rowset_count(const Table *t, const RowSet *rs) {
+    size_t n = 0; for (size_t w = 0; w < ROW_WORDS; ++w) n += DODA_POPCOUNT64(rs->bits[w] & ~t->deleted_bits[w]); return n;
+}
+
+size_t rowset_select(const Table *t, const RowSet *rs, row_callback cb, void *user) {
+    size_t n = 0; for (size_t w = 0; w < ROW_WORDS; ++w) n += emit_word(t, w, rs->bits[w] & ~t->deleted_bits[w], cb, user);
+    STAT_ADD(rows_matched, n); return n;
+}
+
+static size_t idx_lower_bound_int(const Table *t, int col, const Index *idx, int key) {
+    size_t lo = 0, hi = idx->size; while (lo < hi) { size_t mid = (lo + hi) >> 1; int v = t->columns[col].data.int_data[idx->rows[mid]]; if (v < key) lo = mid + 1; else hi = mid; } return lo;
 }
 #ifndef DRIVERSQL_NO_FLOAT
-static ssize_t idx_lower_bound_float(const Table *t, int col, const Index *idx, float key) {
-    size_t lo = 0, hi = idx->size; while (lo < hi) { size_t mid=(lo+hi)>>1; float v=t->columns[col].data.float_data[idx->rows[mid]]; if (v<key) lo=mid+1; else hi=mid; } return (ssize_t)lo;
+static size_t idx_lower_bound_float(const Table *t, int col, const Index *idx, float key) {
+    size_t lo = 0, hi = idx->size; while (lo < hi) { size_t mid=(lo+hi)>>1; float v=t->columns[col].data.float_data[idx->rows[mid]]; if (v<key) lo=mid+1; else hi=mid; } return lo;
 }
 #endif
 #ifndef DRIVERSQL_NO_DOUBLE
-static ssize_t idx_lower_bound_double(const Table *t, int col, const Index *idx, double key) {
-    size_t lo = 0, hi = idx->size; while (lo < hi) { size_t mid=(lo+hi)>>1; double v=t->columns[col].data.double_data[idx->rows[mid]]; if (v<key) lo=mid+1; else hi=mid; } return (ssize_t)lo;
+static size_t idx_lower_bound_double(const Table *t, int col, const Index *idx, double key) {
+    size_t lo = 0, hi = idx->size; while (lo < hi) { size_t mid=(lo+hi)>>1; double v=t->columns[col].data.double_data[idx->rows[mid]]; if (v<key) lo=mid+1; else hi=mid; } return lo;
 }
 #endif
 #ifndef DRIVERSQL_NO_TEXT
-static ssize_t idx_lower_bound_text(const Table *t, int col, const Index *idx, const char *key) {
-    size_t lo=0, hi=idx->size; while (lo<hi){ size_t mid=(lo+hi)>>1; const char *v=t->columns[col].data.text_data[idx->rows[mid]]; if (strncmp(v,key,MAX_TEXT_LEN)<0) lo=mid+1; else hi=mid;} return (ssize_t)lo;
+static size_t idx_lower_bound_text(const Table *t, int col, const Index *idx, const char *key) {
+    size_t lo=0, hi=idx->size; while (lo<hi){ size_t mid=(lo+hi)>>1; const char *v=t->columns[col].data.text_data[idx->rows[mid]]; if (strncmp(v,key,MAX_TEXT_LEN)<0) lo=mid+1; else hi=mid;} return lo;
 }
 #endif
 
-IndexStatus index_select_eq(const Table *t, const Index *idx, const void *value, row_callback cb, void *user) {
+static IndexStatus index_select_eq_impl(const Table *t, const Index *idx, const void *value, row_callback cb, void *user) {
     if (!idx || !idx->active) return IDX_EMPTY; int col = idx->column_id; ColumnType ct = t->columns[col].type;
     if (ct == COL_INT) {
-        int key = *(const int *)value; ssize_t pos = idx_lower_bound_int(t, col, idx, key); if ((size_t)pos >= idx->size) return IDX_OK;
-        for (size_t i = (size_t)pos; i < idx->size; ++i) { int v = t->columns[col].data.int_data[idx->rows[i]]; if (v != key) break; cb(t, idx->rows[i], user); }
+        int key = *(const int *)value; size_t pos = idx_lower_bound_int(t, col, idx, key); if (pos >= idx->size) return IDX_OK;
+        for (size_t i = pos; i < idx->size; ++i) { int v = t->columns[col].data.int_data[idx->rows[i]]; if (v != key) break; cb(t, idx->rows[i], user); }
         return IDX_OK;
     }
 #ifndef DRIVERSQL_NO_FLOAT
     else if (ct == COL_FLOAT) {
-        float key = *(const float *)value; ssize_t pos = idx_lower_bound_float(t, col, idx, key); if ((size_t)pos >= idx->size) return IDX_OK;
-        for (size_t i = (size_t)pos; i < idx->size; ++i) { float v = t->columns[col].data.float_data[idx->rows[i]]; if (v != key) break; cb(t, idx->rows[i], user); }
+        float key = *(const float *)value; size_t pos = idx_lower_bound_float(t, col, idx, key); if (pos >= idx->size) return IDX_OK;
+        for (size_t i = pos; i < idx->size; ++i) { float v = t->columns[col].data.float_data[idx->rows[i]]; if (v != key) break; cb(t, idx->rows[i], user); }
         return IDX_OK;
     }
 #endif
 #ifndef DRIVERSQL_NO_DOUBLE
     else if (ct == COL_DOUBLE) {
-        double key = *(const double *)value; ssize_t pos = idx_lower_bound_double(t, col, idx, key); if ((size_t)pos >= idx->size) return IDX_OK;
-        for (size_t i = (size_t)pos; i < idx->size; ++i) { double v = t->columns[col].data.double_data[idx->rows[i]]; if (v != key) break; cb(t, idx->rows[i], user); }
+        double key = *(const double *)value; size_t pos = idx_lower_bound_double(t, col, idx, key); if (pos >= idx->size) return IDX_OK;
+        for (size_t i = pos; i < idx->size; ++i) { double v = t->columns[col].data.double_data[idx->rows[i]]; if (v != key) break; cb(t, idx->rows[i], user); }
         return IDX_OK;
     }
 #endif
 #ifndef DRIVERSQL_NO_TEXT
     else if (ct == COL_TEXT) {
-        const char *key = (const char *)value; ssize_t pos = idx_lower_bound_text(t, col, idx, key); if ((size_t)pos >= idx->size) return IDX_OK;
-        for (size_t i = (size_t)pos; i < idx->size; ++i) { const char *v = t->columns[col].data.text_data[idx->rows[i]]; if (strncmp(v, key, MAX_TEXT_LEN) != 0) break; cb(t, idx->rows[i], user); }
+        const char *key = (const char *)value; size_t pos = idx_lower_bound_text(t, col, idx, key); if (pos >= idx->size) return IDX_OK;
+        for (size_t i = pos; i < idx->size; ++i) { const char *v = t->columns[col].data.text_data[idx->rows[i]]; if (strncmp(v, key, MAX_TEXT_LEN) != 0) break; cb(t, idx->rows[i], user); }
         return IDX_OK;
     }
 #endif
     return IDX_UNSUPPORTED;
 }
 
-IndexStatus index_select_op(const Table *t, const Index *idx, Op op, const void *value, row_callback cb, void *user) {
+IndexStatus index_select_eq(const Table *t, const Index *idx, const void *value, row_callback cb, void *user) {
+    STAT_BEGIN(); STAT_WRAP_CB(cb, user); IndexStatus res = index_select_eq_impl(t, idx, value, cb, user); STAT_UNWRAP_CB(); STAT_END(STAT_INDEX_SELECT_EQ); return res;
+}
+
+static IndexStatus index_select_op_impl(const Table *t, const Index *idx, Op op, const void *value, row_callback cb, void *user) {
     if (!idx || !idx->active) return IDX_EMPTY; int col = idx->column_id; ColumnType ct = t->columns[col].type;
     if (ct == COL_INT) {
-        int key = *(const int *)value; size_t start = (size_t)idx_lower_bound_int(t, col, idx, key);
+        int key = *(const int *)value; size_t start = idx_lower_bound_int(t, col, idx, key);
         if (op == OP_EQ) { for (size_t i = start; i < idx->size; ++i) { int v=t->columns[col].data.int_data[idx->rows[i]]; if (v!=key) break; cb(t, idx->rows[i], user);} return IDX_OK; }
         if (op == OP_LT) { for (size_t i = 0; i < start; ++i) cb(t, idx->rows[i], user); return IDX_OK; }
         size_t s = (op == OP_GT) ? (start + (start < idx->size && t->columns[col].data.int_data[idx->rows[start]] == key)) : start;
@@ -425,7 +646,7 @@ IndexStatus index_select_op(const Table *t, const Index *idx, Op op, const void
     }
 #ifndef DRIVERSQL_NO_FLOAT
     else if (ct == COL_FLOAT) {
-        float key = *(const float *)value; size_t start = (size_t)idx_lower_bound_float(t, col, idx, key);
+        float key = *(const float *)value; size_t start = idx_lower_bound_float(t, col, idx, key);
         if (op == OP_EQ) { for (size_t i = start; i < idx->size; ++i) { float v=t->columns[col].data.float_data[idx->rows[i]]; if (v!=key) break; cb(t, idx->rows[i], user);} return IDX_OK; }
         if (op == OP_LT) { for (size_t i = 0; i < start; ++i) cb(t, idx->rows[i], user); return IDX_OK; }
         size_t s = (op == OP_GT) ? (start + (start < idx->size && t->columns[col].data.float_data[idx->rows[start]] == key)) : start;
@@ -435,7 +656,7 @@ IndexStatus index_select_op(const Table *t, const Index *idx, Op op, const void
 #endif
 #ifndef DRIVERSQL_NO_DOUBLE
     else if (ct == COL_DOUBLE) {
-        double key = *(const double *)value; size_t start = (size_t)idx_lower_bound_double(t, col, idx, key);
+        double key = *(const double *)value; size_t start = idx_lower_bound_double(t, col, idx, key);
         if (op == OP_EQ) { for (size_t i = start; i < idx->size; ++i) { double v=t->columns[col].data.double_data[idx->rows[i]]; if (v!=key) break; cb(t, idx->rows[i], user);} return IDX_OK; }
         if (op == OP_LT) { for (size_t i = 0; i < start; ++i) cb(t, idx->rows[i], user); return IDX_OK; }
         size_t s = (op == OP_GT) ? (start + (start < idx->size && t->columns[col].data.double_data[idx->rows[start]] == key)) : start;
@@ -445,31 +666,106 @@ IndexStatus index_select_op(const Table *t, const Index *idx, Op op, const void
 #endif
 #ifndef DRIVERSQL_NO_TEXT
     else if (ct == COL_TEXT) {
-        if (op != OP_EQ) return IDX_UNSUPPORTED; return index_select_eq(t, idx, value, cb, user);
+        if (op != OP_EQ) return IDX_UNSUPPORTED; return index_select_eq_impl(t, idx, value, cb, user);
     }
 #endif
     return IDX_UNSUPPORTED;
 }
 
-bool agg_min_int(const Table *t, const char *col_name, int *out) {
+IndexStatus index_select_op(const Table *t, const Index *idx, Op op, const void *value, row_callback cb, void *user) {
+    STAT_BEGIN(); STAT_WRAP_CB(cb, user); IndexStatus res = index_select_op_impl(t, idx, op, value, cb, user); STAT_UNWRAP_CB(); STAT_END(STAT_INDEX_SELECT_OP); return res;
+}
+
+static bool agg_min_int_impl(const Table *t, const char *col_name, int *out) {
     if (!t || !col_name || !out) return false; int idx = column_index(t, col_name); if (idx < 0) return false;
-    const Column *c = &t->columns[idx]; if (c->type != COL_INT) return false; bool any=false; int minv=0;
+    const Column *c = &t->columns[idx]; if (c->type != COL_INT) return false; bool any=false; int minv=0; STAT_ADD(rows_scanned, t->count);
     for (size_t r=0; r<t->count; ++r) { if (is_deleted(t,r)) continue; int v=c->data.int_data[r]; if (!any || v<minv) { minv=v; any=true; } }
     if (!any) return false; *out=minv; return true;
 }
 
-bool agg_max_int(const Table *t, const char *col_name, int *out) {
+bool agg_min_int(const Table *t, const char *col_name, int *out) {
+    STAT_BEGIN(); bool res = agg_min_int_impl(t, col_name, out); STAT_END(STAT_AGG); return res;
+}
+
+static bool agg_max_int_impl(const Table *t, const char *col_name, int *out) {
     if (!t || !col_name || !out) return false; int idx = column_index(t, col_name); if (idx < 0) return false;
-    const Column *c = &t->columns[idx]; if (c->type != COL_INT) return false; bool any=false; int maxv=0;
+    const Column *c = &t->columns[idx]; if (c->type != COL_INT) return false; bool any=false; int maxv=0; STAT_ADD(rows_scanned, t->count);
     for (size_t r=0; r<t->count; ++r) { if (is_deleted(t,r)) continue; int v=c->data.int_data[r]; if (!any || v>maxv) { maxv=v; any=true; } }
     if (!any) return false; *out=maxv; return true;
 }
 
-bool agg_avg_int(const Table *t, const char *col_name, double *out) {
+bool agg_max_int(const Table *t, const char *col_name, int *out) {
+    STAT_BEGIN(); bool res = agg_max_int_impl(t, col_name, out); STAT_END(STAT_AGG); return res;
+}
+
+static bool agg_avg_int_impl(const Table *t, const char *col_name, double *out) {
     if (!t || !col_name || !out) return false; int idx = column_index(t, col_name); if (idx < 0) return false;
-    const Column *c = &t->columns[idx]; if (c->type != COL_INT) return false; size_t n=0; long long sum=0;
+    const Column *c = &t->columns[idx]; if (c->type != COL_INT) return false; size_t n=0; long long sum=0; STAT_ADD(rows_scanned, t->count);
     for (size_t r=0; r<t->count; ++r) { if (is_deleted(t,r)) continue; sum += (long long)c->data.int_data[r]; n++; }
     if (n==0) return false; *out = (double)sum / (double)n; return true;
 }
 
-size_t agg_count(const Table *t) { if (!t) return 0; size_t n=0; for (size_t r=0; r<t->count; ++r) if (!is_deleted(t,r)) n++; return n; }
\ No newline at end of file
+bool agg_avg_int(const Table *t, const char *col_name, double *out) {
+    STAT_BEGIN(); bool res = agg_avg_int_impl(t, col_name, out); STAT_END(STAT_AGG); return res;
+}
+
+static size_t agg_count_impl(const Table *t) { if (!t) return 0; STAT_ADD(rows_scanned, t->count); size_t n=0; for (size_t r=0; r<t->count; ++r) if (!is_deleted(t,r)) n++; return n; }
+
+size_t agg_count(const Table *t) {
+    STAT_BEGIN(); size_t res = agg_count_impl(t); STAT_END(STAT_AGG); return res;
+}
+#ifndef DRIVERSQL_NO_TEXT
+static inline uint32_t hash_text(const char *s) {
+    uint32_t h = 2166136261u; for (size_t i = 0; i < MAX_TEXT_LEN && s[i]; ++i) { h ^= (uint8_t)s[i]; h *= 16777619u; } return h;
+}
+#endif
+
+static DSStatus agg_group_by_impl(const Table *t, const char *key_col, const char *val_col, const char *time_col, int t0, int t1, GroupBy *out) {
+    if (!t || !key_col || !val_col || !out) return DS_ERR_INVALID;
+    int kc = column_index(t, key_col), vc = column_index(t, val_col), tc = -1; if (kc < 0 || vc < 0) return DS_ERR_NOT_FOUND;
+    if (time_col) { tc = column_index(t, time_col); if (tc < 0) return DS_ERR_NOT_FOUND; if (t->columns[tc].type != COL_INT) return DS_ERR_UNSUPPORTED; }
+    ColumnType kt = t->columns[kc].type;
+#ifndef DRIVERSQL_NO_TEXT
+    if (kt != COL_INT && kt != COL_TEXT) return DS_ERR_UNSUPPORTED;
+#else
+    if (kt != COL_INT) return DS_ERR_UNSUPPORTED;
+#endif
+    if (t->columns[vc].type != COL_INT) return DS_ERR_UNSUPPORTED;
+    memset(out->slots, 0, sizeof(out->slots)); out->key_column = kc; out->size = 0; out->dropped = 0;
+    const int *vals = t->columns[vc].data.int_data; STAT_ADD(rows_scanned, t->count);
+    for (size_t r = 0; r < t->count; ++r) {
+        if (is_deleted(t, r)) continue;
+        if (tc >= 0) { int tv = t->columns[tc].data.int_data[r]; if (tv < t0 || tv >= t1) continue; }
+        uint32_t h; int ikey = 0;
+#ifndef DRIVERSQL_NO_TEXT
+        const char *skey = NULL;
+        if (kt == COL_TEXT) { skey = t->columns[kc].data.text_data[r]; h = hash_text(skey); }
+        else
+#endif
+        { ikey = t->columns[kc].data.int_data[r]; h = hash32((uint32_t)ikey); }
+        GroupAgg *g = NULL;
+        for (uint32_t i = 0; i < DRIVERSQL_GROUP_HASH_SIZE; ++i) {
+            uint32_t s = (h + i) & (DRIVERSQL_GROUP_HASH_SIZE - 1);
+            uint16_t slot = out->slots[s];
+            if (slot == 0) {
+                if (out->size >= DRIVERSQL_GROUP_MAX) break;
+                g = &out->groups[out->size++]; out->slots[s] = (uint16_t)out->size;
+                g->key_row = (uint16_t)r; g->key = ikey; g->count = 0; g->sum = 0; g->min = vals[r]; g->max = vals[r]; g->avg = 0.0;
+                break;
+            }
+            GroupAgg *cand = &out->groups[slot - 1];
+#ifndef DRIVERSQL_NO_TEXT
+            if (skey) { if (strncmp(t->columns[kc].data.text_data[cand->key_row], skey, MAX_TEXT_LEN) == 0) { g = cand; break; } continue; }
+#endif
+            if (cand->key == ikey) { g = cand; break; }
+        }
+        if (!g) { out->dropped++; continue; }
+        int v = vals[r]; g->count++; g->sum += v; if (v < g->min) g->min = v; if (v > g->max) g->max = v;
+    }
+    for (size_t i = 0; i < out->size; ++i) out->groups[i].avg = (double)out->groups[i].sum / (double)out->groups[i].count;
+    return out->dropped ? DS_ERR_FULL : DS_OK;
+}
+
+DSStatus agg_group_by(const Table *t, const char *key_col, const char *val_col, const char *time_col, int t0, int t1, GroupBy *out) {
+    STAT_BEGIN(); DSStatus res = agg_group_by_impl(t, key_col, val_col, time_col, t0, t1, out); STAT_END(STAT_AGG); return res;
+}
@@ -27,15 +27,42 @@
 #ifndef DRIVERSQL_HASH_SIZE
 #define DRIVERSQL_HASH_SIZE 512
 #endif
+#ifndef DRIVERSQL_GROUP_MAX
+#define DRIVERSQL_GROUP_MAX 256 // e.g. one group per device for a ~200-device fleet
+#endif
+#ifndef DRIVERSQL_GROUP_HASH_SIZE
+#define DRIVERSQL_GROUP_HASH_SIZE 512
+#endif
+#if DRIVERSQL_GROUP_HASH_SIZE < DRIVERSQL_GROUP_MAX
+#error "DRIVERSQL_GROUP_HASH_SIZE must be >= DRIVERSQL_GROUP_MAX"
+#endif
+#if (DRIVERSQL_GROUP_HASH_SIZE & (DRIVERSQL_GROUP_HASH_SIZE - 1)) != 0
+#error "DRIVERSQL_GROUP_HASH_SIZE must be a power of two"
+#endif
+#ifndef DRIVERSQL_BITMAP_MAX_VALUES
+#define DRIVERSQL_BITMAP_MAX_VALUES 8
+#endif
 
 #define MAX_COLUMNS DRIVERSQL_MAX_COLUMNS
 #define MAX_NAME_LEN DRIVERSQL_MAX_NAME_LEN
 #define MAX_TEXT_LEN DRIVERSQL_MAX_TEXT_LEN
 #define MAX_ROWS DRIVERSQL_MAX_ROWS
 #define HASH_SIZE DRIVERSQL_HASH_SIZE
+#define ROW_WORDS ((MAX_ROWS + 63) / 64) // 64-row words in a per-row bitmap
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DODA_CTZ64(x) ((unsigned)__builtin_ctzll(x))
+#define DODA_POPCOUNT64(x) ((size_t)__builtin_popcountll(x))
+#else
+static inline unsigned doda_ctz64(uint64_t x) { unsigned n = 0; while (!(x & 1ULL)) { x >>= 1; n++; } return n; }
+static inline size_t doda_popcount64(uint64_t x) { size_t n = 0; while (x) { x &= x - 1; n++; } return n; }
+#define DODA_CTZ64(x) doda_ctz64(x)
+#define DODA_POPCOUNT64(x) doda_popcount64(x)
+#endif
 
 // Feature gates
 // DRIVERSQL_NO_TEXT, DRIVERSQL_NO_FLOAT, DRIVERSQL_NO_DOUBLE, DRIVERSQL_NO_POINTER_COLUMN, DRIVERSQL_NO_STDIO
+// DRIVERSQL_STATS (opt-in performance counters and latency histograms)
 
 typedef enum {
     COL_INT = 0,
@@ -62,7 +89,7 @@ typedef struct Column {
 #ifndef DRIVERSQL_NO_TEXT
         char text_data[MAX_ROWS][MAX_TEXT_LEN];
 #endif
-        uint8_t bool_data[MAX_ROWS];
+        uint64_t bool_bits[ROW_WORDS]; // packed, same word/bit layout as deleted_bits
 #ifndef DRIVERSQL_NO_FLOAT
         float float_data[MAX_ROWS];
 #endif
@@ -81,12 +108,19 @@ typedef struct Table {
     Column columns[MAX_COLUMNS];
     size_t capacity;
     size_t count;
-    uint64_t deleted_bits[(MAX_ROWS + 63) / 64];
+    uint64_t deleted_bits[ROW_WORDS];
     uint16_t free_list[MAX_ROWS];
     size_t free_top;
     uint16_t pk_hash[HASH_SIZE];
+    uint32_t generation; // bumped each time a row becomes live; snapshot indexes compare it
 } Table;
 
+static inline bool column_bool_get(const Column *c, size_t row) { return (c->data.bool_bits[row / 64] >> (row % 64)) & 1ULL; }
+static inline void column_bool_set(Column *c, size_t row, bool v) {
+    uint64_t mask = 1ULL << (row % 64);
+    if (v) c->data.bool_bits[row / 64] |= mask; else c->data.bool_bits[row / 64] &= ~mask;
+}
+
 typedef struct {
     int column_id;
     uint16_t rows[MAX_ROWS];
@@ -94,10 +128,59 @@ typedef struct {
     bool active;
 } Index;
 
+// One GROUP BY bucket. For TEXT keys read the key back from key_row.
+typedef struct {
+    uint16_t key_row;
+    int key;
+    size_t count;
+    long long sum;
+    int min;
+    int max;
+    double avg;
+} GroupAgg;
+
+// Statically sized GROUP BY result; slots is an open-addressed hash (group index + 1, 0 = empty)
+typedef struct {
+    int key_column;
+    GroupAgg groups[DRIVERSQL_GROUP_MAX];
+    size_t size;
+    size_t dropped; // rows whose group did not fit (see DS_ERR_FULL)
+    uint16_t slots[DRIVERSQL_GROUP_HASH_SIZE];
+} GroupBy;
+
+// Bitmap index for a small-domain INT column (status/alarm codes): one row bitmap per distinct value.
+// It records Table.generation when built: after any insert (including one that reuses a deleted
+// slot) the index is stale and rowset_from_bitmap_* return DS_ERR_INVALID until it is refreshed.
+// Deleted rows are masked out at query time, so deletes alone do not make it stale.
+typedef struct {
+    int column_id;
+    uint32_t generation;
+    size_t value_count;
+    int values[DRIVERSQL_BITMAP_MAX_VALUES];
+    uint64_t bits[DRIVERSQL_BITMAP_MAX_VALUES][ROW_WORDS];
+    bool active;
+} BitmapIndex;
+
+// Set of row ids, one bit per row; combine predicates with rowset_and/or/andnot
+typedef struct {
+    uint64_t bits[ROW_WORDS];
+} RowSet;
+
 typedef void (*row_callback)(const struct Table *t, size_t row, void *user);
 
 typedef enum { OP_EQ = 0, OP_GT, OP_LT, OP_GTE } Op;
 
+// Compare one 64-row word of a BOOL column (bool_bits[w]) against key (false < true)
+static inline uint64_t bool_match_word(uint64_t v, Op op, bool key) {
+    switch (op) {
+        case OP_EQ: return key ? v : ~v;
+        case OP_GT: return key ? 0 : v;
+        case OP_LT: return key ? ~v : 0;
+        case OP_GTE: return key ? v : ~0ULL;
+    }
+    return 0;
+}
+
 typedef enum {
     DS_OK = 0,
     DS_ERR_FULL,
@@ -110,11 +193,24 @@ typedef enum {
 void init_table(Table *t, const char *name, int column_count, const char **col_names, const ColumnType *col_types);
 DSStatus insert_row_int_text_int(Table *t, int v0, const char *v1, int v2);
 DSStatus insert_row(Table *t, const void *values[]);
+// Batch insert of n rows given column-major arrays: columns[i] points to n values of column i
+// (int for INT/BOOL, float, double, char[n][MAX_TEXT_LEN] for TEXT, void *[n] for POINTER).
+// Returns DS_ERR_FULL when capacity runs out and DS_ERR_UNSUPPORTED if any PK was a duplicate;
+// *inserted_out counts the rows actually stored.
+DSStatus insert_rows(Table *t, const void *const columns[], size_t n, size_t *inserted_out);
 DSStatus select_where_eq(const Table *t, const char *col_name, const void *eq_value, row_callback cb, void *user);
 DSStatus select_where_op(const Table *t, const char *col_name, Op op, const void *value, row_callback cb, void *user);
 DSStatus delete_where_eq(Table *t, const char *col_name, const void *eq_value, size_t *deleted_out);
 void free_table(Table *t);
 
+// Row allocation shared by insert_row and typed schema tables (doda_schema.h):
+// reserve a slot (free list first), write its columns, then commit to clear the deleted bit and index the PK.
+// A duplicate PK makes commit return DS_ERR_UNSUPPORTED and releases the slot.
+DSStatus table_reserve_row(Table *t, size_t *row_out);
+DSStatus table_commit_row(Table *t, size_t row);
+// Delete a live row: drop its PK from pk_hash, set the deleted bit and push the slot on the free list.
+void table_delete_row(Table *t, size_t row);
+
 int column_index(const Table *t, const char *col_name);
 bool is_deleted(const Table *t, size_t row);
 #ifndef DRIVERSQL_NO_STDIO
@@ -127,10 +223,82 @@ typedef enum { IDX_OK = 0, IDX_UNSUPPORTED, IDX_EMPTY } IndexStatus;
 IndexStatus index_select_eq(const Table *t, const Index *idx, const void *value, row_callback cb, void *user);
 IndexStatus index_select_op(const Table *t, const Index *idx, Op op, const void *value, row_callback cb, void *user);
 
+// Bitmap predicates. Every rowset_from_* result contains only live rows (not deleted, below count).
+// bitmap_index_build returns DS_ERR_FULL (index left inactive) if the column has more than
+// DRIVERSQL_BITMAP_MAX_VALUES distinct values among live rows.
+DSStatus bitmap_index_build(const Table *t, BitmapIndex *bm, const char *col_name);
+// Rebuild an active index if the table changed since it was built; DS_OK if it was already current.
+DSStatus bitmap_index_refresh(const Table *t, BitmapIndex *bm);
+void bitmap_index_drop(BitmapIndex *bm);
+void rowset_all(const Table *t, RowSet *out);
+DSStatus rowset_from_bool(const Table *t, const char *col_name, bool value, RowSet *out);
+DSStatus rowset_from_bitmap_eq(const Table *t, const BitmapIndex *bm, int value, RowSet *out);
+DSStatus rowset_from_bitmap_in(const Table *t, const BitmapIndex *bm, const int *values, size_t n, RowSet *out);
+void rowset_and(RowSet *dst, const RowSet *src);
+void rowset_or(RowSet *dst, const RowSet *src);
+void rowset_andnot(RowSet *dst, const RowSet *src);
+// count/select re-apply the deleted bitmap, so rows deleted after the set was built are skipped.
+// A RowSet is only valid until the next insert: a reused slot would be reported with its new contents.
+size_t rowset_count(const Table *t, const RowSet *rs);
+size_t rowset_select(const Table *t, const RowSet *rs, row_callback cb, void *user);
+
+// Single-pass hash GROUP BY on an INT or TEXT key with count/sum/min/max/avg of an INT value column.
+// If time_col is non-NULL only rows with t0 <= time < t1 are aggregated.
+// Returns DS_ERR_FULL when more than DRIVERSQL_GROUP_MAX groups exist; out->dropped counts the skipped rows.
+DSStatus agg_group_by(const Table *t, const char *key_col, const char *val_col, const char *time_col, int t0, int t1, GroupBy *out);
+
+#ifdef DRIVERSQL_STATS
+#ifndef DRIVERSQL_STATS_BUCKETS
+#define DRIVERSQL_STATS_BUCKETS 32
+#endif
+
+// Caller-supplied monotonic clock (cycles, ns, ...); latencies are recorded in its ticks
+typedef uint64_t (*stats_clock_fn)(void);
+
+typedef enum {
+    STAT_INSERT_ROW = 0,
+    STAT_INSERT_ROWS,
+    STAT_SELECT_WHERE_EQ,
+    STAT_SELECT_WHERE_OP,
+    STAT_INDEX_BUILD,
+    STAT_INDEX_SELECT_EQ,
+    STAT_INDEX_SELECT_OP,
+    STAT_AGG,
+    STAT_OP_COUNT
+} StatOp;
+
+// Log2 histogram: buckets[i] counts calls taking [2^i, 2^(i+1)) ticks (bucket 0 also holds 0)
+typedef struct {
+    uint64_t calls;
+    uint64_t total_ticks;
+    uint64_t max_ticks;
+    uint64_t buckets[DRIVERSQL_STATS_BUCKETS];
+} LatencyHist;
+
+typedef struct {
+    uint64_t rows_scanned;    // rows visited by full scans (select_where_*, agg_*, agg_group_by)
+    uint64_t rows_matched;    // rows passed to callbacks by select_where_* / index_select_*
+    uint64_t pk_probes;       // pk_hash lookups/inserts
+    uint64_t pk_probe_steps;  // total slots visited; steps / probes = mean probe length
+    uint64_t pk_probe_max;
+    uint64_t free_list_reuse; // inserts that reused a deleted slot
+    LatencyHist latency[STAT_OP_COUNT]; // index rebuild time is latency[STAT_INDEX_BUILD]
+} EngineStats;
+
+// Global, single-writer like the rest of the engine. Latencies are only recorded once a clock is set.
+void stats_set_clock(stats_clock_fn clock);
+void stats_snapshot(EngineStats *out);
+void stats_reset(void);
+#endif
+
 // DODA renamed types (backward-compatible typedefs)
 typedef ColumnType DodaColumnType;
 typedef Table DodaTable;
 typedef Index DodaIndex;
+typedef GroupAgg DodaGroupAgg;
+typedef GroupBy DodaGroupBy;
+typedef BitmapIndex DodaBitmapIndex;
+typedef RowSet DodaRowSet;
 
 typedef void (*doda_row_callback)(const DodaTable *t, size_t row, void *user);
 
@@ -148,6 +316,7 @@ typedef enum {
 static inline void doda_init_table(DodaTable *t, const char *name, int column_count, const char **col_names, const DodaColumnType *col_types) { init_table((Table*)t, name, column_count, col_names, (const ColumnType*)col_types); }
 static inline DodaStatus doda_insert_row_int_text_int(DodaTable *t, int v0, const char *v1, int v2) { return (DodaStatus)insert_row_int_text_int((Table*)t, v0, v1, v2); }
 static inline DodaStatus doda_insert_row(DodaTable *t, const void *values[]) { return (DodaStatus)insert_row((Table*)t, values); }
+static inline DodaStatus doda_insert_rows(DodaTable *t, const void *const columns[], size_t n, size_t *inserted_out) { return (DodaStatus)insert_rows((Table*)t, columns, n, inserted_out); }
 static inline DodaStatus doda_select_where_eq(const DodaTable *t, const char *col_name, const void *eq_value, doda_row_callback cb, void *user) { return (DodaStatus)select_where_eq((const Table*)t, col_name, eq_value, (row_callback)cb, user); }
 static inline DodaStatus doda_select_where_op(const DodaTable *t, const char *col_name, DodaOp op, const void *value, doda_row_callback cb, void *user) { return (DodaStatus)select_where_op((const Table*)t, col_name, (Op)op, value, (row_callback)cb, user); }
 static inline DodaStatus doda_delete_where_eq(DodaTable *t, const char *col_name, const void *eq_value, size_t *deleted_out) { return (DodaStatus)delete_where_eq((Table*)t, col_name, eq_value, deleted_out); }
@@ -164,3 +333,23 @@ static inline void doda_index_drop(DodaIndex *idx) { index_drop((Index*)idx); }
 typedef enum { DodaIndexStatus_OK = IDX_OK, DodaIndexStatus_UNSUPPORTED = IDX_UNSUPPORTED, DodaIndexStatus_EMPTY = IDX_EMPTY } DodaIndexStatus;
 static inline DodaIndexStatus doda_index_select_eq(const DodaTable *t, const DodaIndex *idx, const void *value, doda_row_callback cb, void *user) { return (DodaIndexStatus)index_select_eq((const Table*)t, (const Index*)idx, value, (row_callback)cb, user); }
 static inline DodaIndexStatus doda_index_select_op(const DodaTable *t, const DodaIndex *idx, DodaOp op, const void *value, doda_row_callback cb, void *user) { return (DodaIndexStatus)index_select_op((const Table*)t, (const Index*)idx, (Op)op, value, (row_callback)cb, user); }
+static inline DodaStatus doda_bitmap_index_build(const DodaTable *t, DodaBitmapIndex *bm, const char *col_name) { return (DodaStatus)bitmap_index_build((const Table*)t, (BitmapIndex*)bm, col_name); }
+static inline DodaStatus doda_bitmap_index_refresh(const DodaTable *t, DodaBitmapIndex *bm) { return (DodaStatus)bitmap_index_refresh((const Table*)t, (BitmapIndex*)bm); }
+static inline void doda_bitmap_index_drop(DodaBitmapIndex *bm) { bitmap_index_drop((BitmapIndex*)bm); }
+static inline void doda_rowset_all(const DodaTable *t, DodaRowSet *out) { rowset_all((const Table*)t, (RowSet*)out); }
+static inline DodaStatus doda_rowset_from_bool(const DodaTable *t, const char *col_name, bool value, DodaRowSet *out) { return (DodaStatus)rowset_from_bool((const Table*)t, col_name, value, (RowSet*)out); }
+static inline DodaStatus doda_rowset_from_bitmap_eq(const DodaTable *t, const DodaBitmapIndex *bm, int value, DodaRowSet *out) { return (DodaStatus)rowset_from_bitmap_eq((const Table*)t, (const BitmapIndex*)bm, value, (RowSet*)out); }
+static inline DodaStatus doda_rowset_from_bitmap_in(const DodaTable *t, const DodaBitmapIndex *bm, const int *values, size_t n, DodaRowSet *out) { return (DodaStatus)rowset_from_bitmap_in((const Table*)t, (const BitmapIndex*)bm, values, n, (RowSet*)out); }
+static inline void doda_rowset_and(DodaRowSet *dst, const DodaRowSet *src) { rowset_and((RowSet*)dst, (const RowSet*)src); }
+static inline void doda_rowset_or(DodaRowSet *dst, const DodaRowSet *src) { rowset_or((RowSet*)dst, (const RowSet*)src); }
+static inline void doda_rowset_andnot(DodaRowSet *dst, const DodaRowSet *src) { rowset_andnot((RowSet*)dst, (const RowSet*)src); }
+static inline size_t doda_rowset_count(const DodaTable *t, const DodaRowSet *rs) { return rowset_count((const Table*)t, (const RowSet*)rs); }
+static inline size_t doda_rowset_select(const DodaTable *t, const DodaRowSet *rs, doda_row_callback cb, void *user) { return rowset_select((const Table*)t, (const RowSet*)rs, (row_callback)cb, user); }
+static inline DodaStatus doda_agg_group_by(const DodaTable *t, const char *key_col, const char *val_col, const char *time_col, int t0, int t1, DodaGroupBy *out) { return (DodaStatus)agg_group_by((const Table*)t, key_col, val_col, time_col, t0, t1, (GroupBy*)out); }
+
+#ifdef DRIVERSQL_STATS
+typedef EngineStats DodaStats;
+static inline void doda_stats_set_clock(stats_clock_fn clock) { stats_set_clock(clock); }
+static inline void doda_stats_snapshot(DodaStats *out) { stats_snapshot((EngineStats*)out); }
+static inline void doda_stats_reset(void) { stats_reset(); }
+#endif
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2025 Rohit Ballurgi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software... [rest of standard MIT short-text]
+ * ...
+ * MIT License (see LICENSE file for full text)
+ */
+#include "doda_io.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The binary format stores INT as i32 and reads it straight into int staging arrays
+typedef char doda_io_int_is_32bit[sizeof(int) == 4 ? 1 : -1];
+
+static bool io_supported(const Table *t) {
+#ifndef DRIVERSQL_NO_POINTER_COLUMN
+    for (int i = 0; i < t->column_count; ++i) if (t->columns[i].type == COL_POINTER) return false;
+#else
+    (void)t;
+#endif
+    return true;
+}
+
+static size_t io_strnlen(const char *s, size_t max) { size_t n = 0; while (n < max && s[n]) n++; return n; }
+
+static bool host_little_endian(void) { const uint16_t one = 1; return *(const uint8_t *)&one == 1; }
+
+// ---------------------------------------------------------------------------
+// Loader
+
+// Record scanner states: a quote opens a field only as its first byte; inside quotes "" is an escape
+// and any other quote closes the field. A stray quote in an unquoted field is plain data.
+enum { CSV_FIELD_START = 0, CSV_UNQUOTED, CSV_QUOTED, CSV_QUOTE_IN_QUOTED };
+
+void doda_loader_init(DodaLoader *ld, Table *t, doda_read_fn rd, void *ctx) {
+    ld->table = t; ld->read = rd; ld->ctx = ctx;
+    ld->buf_len = 0; ld->buf_pos = 0; ld->line_len = 0;
+    ld->staged = 0; ld->loaded = 0; ld->rejected = 0; ld->lines = 0; ld->csv_state = CSV_FIELD_START;
+}
+
+static bool io_fill(DodaLoader *ld) {
+    if (ld->buf_pos < ld->buf_len) return true;
+    ld->buf_len = ld->read(ld->ctx, ld->buf, sizeof(ld->buf)); ld->buf_pos = 0;
+    return ld->buf_len > 0;
+}
+
+static bool io_read_exact(DodaLoader *ld, void *dst, size_t n) {
+    uint8_t *out = (uint8_t *)dst;
+    while (n) {
+        if (!io_fill(ld)) return false;
+        size_t k = ld->buf_len - ld->buf_pos; if (k > n) k = n;
+        memcpy(out, ld->buf + ld->buf_pos, k); ld->buf_pos += k; out += k; n -= k;
+    }
+    return true;
+}
+
+static DodaStatus io_flush_chunk(DodaLoader *ld) {
+    if (ld->staged == 0) return DodaStatus_OK;
+    const void *cols[MAX_COLUMNS];
+    for (int i = 0; i < ld->table->column_count; ++i) {
+        switch (ld->table->columns[i].type) {
+#ifndef DRIVERSQL_NO_FLOAT
+            case COL_FLOAT: cols[i] = ld->chunk[i].f; break;
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+            case COL_DOUBLE: cols[i] = ld->chunk[i].d; break;
+#endif
+#ifndef DRIVERSQL_NO_TEXT
+            case COL_TEXT: cols[i] = ld->chunk[i].s; break;
+#endif
+            default: cols[i] = ld->chunk[i].i; break;
+        }
+    }
+    size_t ins = 0; DSStatus st = insert_rows(ld->table, cols, ld->staged, &ins);
+    ld->loaded += ins; ld->rejected += ld->staged - ins; ld->staged = 0;
+    return st == DS_ERR_FULL ? DodaStatus_ERR_FULL : DodaStatus_OK;
+}
+
+// Parse one CSV field in place: returns its NUL-terminated start, advances *pp past the field and
+// sets *sep when a comma followed it
+static char *csv_next_field(char **pp, char *end, bool *sep, bool *ok) {
+    char *p = *pp, *start = p, *fend;
+    if (p < end && *p == '"') {
+        char *dst = p; p++;
+        for (;;) {
+            if (p >= end) { *ok = false; return start; }
+            if (*p == '"') { if (p + 1 < end && p[1] == '"') { *dst++ = '"'; p += 2; continue; } p++; break; }
+            *dst++ = *p++;
+        }
+        if (p < end && *p != ',') { *ok = false; return start; }
+        fend = dst;
+    } else {
+        while (p < end && *p != ',') p++;
+        fend = p;
+    }
+    *sep = p < end; if (*sep) p++;
+    *fend = '\0'; *pp = p;
+    return start;
+}
+
+static bool csv_parse_line(DodaLoader *ld, char *line, size_t len) {
+    if (len && line[len - 1] == '\r') len--;
+    char *p = line, *end = line + len; size_t r = ld->staged; bool ok = true, sep = false;
+    for (int i = 0; i < ld->table->column_count; ++i) {
+        if (i > 0 && !sep) return false; // too few fields
+        char *f = csv_next_field(&p, end, &sep, &ok), *fe = NULL; if (!ok) return false;
+        DodaIoChunk *c = &ld->chunk[i];
+        switch (ld->table->columns[i].type) {
+            case COL_INT: { long v = strtol(f, &fe, 10); if (fe == f || *fe || v < INT_MIN || v > INT_MAX) return false; c->i[r] = (int)v; break; }
+            case COL_BOOL: {
+                if (strcmp(f, "1") == 0 || strcmp(f, "true") == 0) c->i[r] = 1;
+                else if (strcmp(f, "0") == 0 || strcmp(f, "false") == 0) c->i[r] = 0;
+                else return false;
+                break;
+            }
+#ifndef DRIVERSQL_NO_FLOAT
+            case COL_FLOAT: c->f[r] = strtof(f, &fe); if (fe == f || *fe) return false; break;
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+            case COL_DOUBLE: c->d[r] = strtod(f, &fe); if (fe == f || *fe) return false; break;
+#endif
+#ifndef DRIVERSQL_NO_TEXT
+            case COL_TEXT: { size_t n = io_strnlen(f, MAX_TEXT_LEN - 1); memcpy(c->s[r], f, n); c->s[r][n] = '\0'; break; }
+#endif
+            default: return false;
+        }
+    }
+    return !sep; // extra fields are an error
+}
+
+static uint8_t csv_scan(uint8_t s, uint8_t c) {
+    if (s == CSV_QUOTED) return c == '"' ? CSV_QUOTE_IN_QUOTED : CSV_QUOTED;
+    if (c == '"' && (s == CSV_FIELD_START || s == CSV_QUOTE_IN_QUOTED)) return CSV_QUOTED;
+    return c == ',' || c == '\n' ? CSV_FIELD_START : CSV_UNQUOTED;
+}
+
+static DodaStatus csv_end_line(DodaLoader *ld, bool *skip_header, bool overflow) {
+    ld->lines++;
+    if (*skip_header) { *skip_header = false; ld->line_len = 0; return DodaStatus_OK; }
+    if (!overflow && ld->line_len == 0) return DodaStatus_OK;
+    ld->line[ld->line_len] = '\0';
+    if (overflow || !csv_parse_line(ld, ld->line, ld->line_len)) ld->rejected++;
+    else if (++ld->staged == DRIVERSQL_IO_CHUNK_ROWS) { ld->line_len = 0; return io_flush_chunk(ld); }
+    ld->line_len = 0;
+    return DodaStatus_OK;
+}
+
+DodaStatus doda_load_csv(DodaLoader *ld, bool has_header) {
+    if (!ld || !ld->table || !ld->read) return DodaStatus_ERR_INVALID;
+    if (!io_supported(ld->table)) return DodaStatus_ERR_UNSUPPORTED;
+    bool skip = has_header, overflow = false; DodaStatus st;
+    while (io_fill(ld)) {
+        const uint8_t *start = ld->buf + ld->buf_pos; size_t avail = ld->buf_len - ld->buf_pos, take = 0; bool nl = false;
+        // A record ends at the first newline outside a quoted field
+        for (; take < avail; ++take) {
+            uint8_t prev = ld->csv_state; ld->csv_state = csv_scan(prev, start[take]);
+            if (start[take] == '\n' && prev != CSV_QUOTED) { nl = true; break; }
+        }
+        if (!overflow && ld->line_len + take < sizeof(ld->line)) { memcpy(ld->line + ld->line_len, start, take); ld->line_len += take; }
+        else overflow = true;
+        ld->buf_pos += take + (nl ? 1 : 0);
+        if (nl) { st = csv_end_line(ld, &skip, overflow); overflow = false; if (st != DodaStatus_OK) return st; }
+    }
+    if (ld->line_len || overflow) { st = csv_end_line(ld, &skip, overflow); if (st != DodaStatus_OK) return st; }
+    return io_flush_chunk(ld);
+}
+
+DodaStatus doda_load_bin(DodaLoader *ld) {
+    if (!ld || !ld->table || !ld->read) return DodaStatus_ERR_INVALID;
+    Table *t = ld->table;
+    if (!io_supported(t)) return DodaStatus_ERR_UNSUPPORTED;
+    uint8_t hdr[10], types[MAX_COLUMNS];
+    if (!io_read_exact(ld, hdr, sizeof(hdr)) || memcmp(hdr, "DODB", 4) != 0 || hdr[4] != DODA_IO_BIN_VERSION) return DodaStatus_ERR_INVALID;
+    if ((hdr[5] == 1) != host_little_endian()) return DodaStatus_ERR_UNSUPPORTED;
+    uint16_t ncols, block_rows; memcpy(&ncols, hdr + 6, 2); memcpy(&block_rows, hdr + 8, 2);
+    if (ncols != t->column_count || block_rows > DRIVERSQL_IO_CHUNK_ROWS || !io_read_exact(ld, types, ncols)) return DodaStatus_ERR_INVALID;
+    for (int i = 0; i < t->column_count; ++i) if (types[i] != (uint8_t)t->columns[i].type) return DodaStatus_ERR_INVALID;
+    for (;;) {
+        uint16_t rows; if (!io_read_exact(ld, &rows, 2)) return DodaStatus_ERR_INVALID;
+        if (rows == 0) break;
+        if (rows > block_rows) return DodaStatus_ERR_INVALID;
+        for (int i = 0; i < t->column_count; ++i) {
+            DodaIoChunk *c = &ld->chunk[i]; bool ok = true;
+            switch (t->columns[i].type) {
+                case COL_INT: ok = io_read_exact(ld, c->i, rows * sizeof(int)); break;
+                case COL_BOOL: {
+                    uint8_t b[DRIVERSQL_IO_CHUNK_ROWS]; ok = io_read_exact(ld, b, rows);
+                    for (size_t r = 0; r < rows; ++r) c->i[r] = b[r] != 0;
+                    break;
+                }
+#ifndef DRIVERSQL_NO_FLOAT
+                case COL_FLOAT: ok = io_read_exact(ld, c->f, rows * sizeof(float)); break;
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+                case COL_DOUBLE: ok = io_read_exact(ld, c->d, rows * sizeof(double)); break;
+#endif
+#ifndef DRIVERSQL_NO_TEXT
+                case COL_TEXT:
+                    for (size_t r = 0; r < rows && ok; ++r) {
+                        uint8_t len, skip[64]; ok = io_read_exact(ld, &len, 1);
+                        size_t keep = len < MAX_TEXT_LEN ? len : MAX_TEXT_LEN - 1, rest = len - keep;
+                        ok = ok && io_read_exact(ld, c->s[r], keep); c->s[r][keep] = '\0';
+                        while (ok && rest) { size_t k = rest < sizeof(skip) ? rest : sizeof(skip); ok = io_read_exact(ld, skip, k); rest -= k; }
+                    }
+                    break;
+#endif
+                default: ok = false; break;
+            }
+            if (!ok) return DodaStatus_ERR_INVALID;
+        }
+        ld->staged = rows;
+        DodaStatus st = io_flush_chunk(ld); if (st != DodaStatus_OK) return st;
+    }
+    return DodaStatus_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Exporter
+
+void doda_export_init(DodaExporter *ex, doda_write_fn wr, void *ctx) {
+    ex->write = wr; ex->ctx = ctx; ex->len = 0; ex->table = NULL;
+    ex->npending = 0; ex->binary = false; ex->error = false; ex->rows = 0;
+}
+
+static void ex_flush(DodaExporter *ex) {
+    if (ex->len && !ex->error && ex->write(ex->ctx, ex->buf, ex->len) != ex->len) ex->error = true;
+    ex->len = 0;
+}
+
+static void ex_put(DodaExporter *ex, const void *p, size_t n) {
+    const uint8_t *src = (const uint8_t *)p;
+    while (n) {
+        if (ex->len == sizeof(ex->buf)) ex_flush(ex);
+        size_t k = sizeof(ex->buf) - ex->len; if (k > n) k = n;
+        memcpy(ex->buf + ex->len, src, k); ex->len += k; src += k; n -= k;
+    }
+}
+
+static void ex_putc(DodaExporter *ex, char ch) { if (ex->len == sizeof(ex->buf)) ex_flush(ex); ex->buf[ex->len++] = (uint8_t)ch; }
+
+static void ex_put_int(DodaExporter *ex, int v) {
+    char tmp[12]; size_t n = sizeof(tmp); unsigned int u = v < 0 ? 0u - (unsigned int)v : (unsigned int)v;
+    do { tmp[--n] = (char)('0' + u % 10); u /= 10; } while (u);
+    if (v < 0) tmp[--n] = '-';
+    ex_put(ex, tmp + n, sizeof(tmp) - n);
+}
+
+#ifndef DRIVERSQL_NO_TEXT
+static void ex_put_csv_text(DodaExporter *ex, const char *s) {
+    size_t n = io_strnlen(s, MAX_TEXT_LEN);
+    if (!memchr(s, ',', n) && !memchr(s, '"', n) && !memchr(s, '\n', n) && !memchr(s, '\r', n)) { ex_put(ex, s, n); return; }
+    ex_putc(ex, '"');
+    for (size_t i = 0; i < n; ++i) { if (s[i] == '"') ex_putc(ex, '"'); ex_putc(ex, s[i]); }
+    ex_putc(ex, '"');
+}
+#endif
+
+static void ex_csv_row(DodaExporter *ex, size_t r) {
+    const Table *t = ex->table;
+#if !defined(DRIVERSQL_NO_FLOAT) || !defined(DRIVERSQL_NO_DOUBLE)
+    char tmp[32];
+#endif
+    for (int i = 0; i < t->column_count; ++i) {
+        const Column *c = &t->columns[i];
+        if (i) ex_putc(ex, ',');
+        switch (c->type) {
+            case COL_INT: ex_put_int(ex, c->data.int_data[r]); break;
+            case COL_BOOL: if (column_bool_get(c, r)) ex_put(ex, "true", 4); else ex_put(ex, "false", 5); break;
+#ifndef DRIVERSQL_NO_FLOAT
+            case COL_FLOAT: ex_put(ex, tmp, (size_t)snprintf(tmp, sizeof(tmp), "%.9g", (double)c->data.float_data[r])); break;
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+            case COL_DOUBLE: ex_put(ex, tmp, (size_t)snprintf(tmp, sizeof(tmp), "%.17g", c->data.double_data[r])); break;
+#endif
+#ifndef DRIVERSQL_NO_TEXT
+            case COL_TEXT: ex_put_csv_text(ex, c->data.text_data[r]); break;
+#endif
+            default: break;
+        }
+    }
+    ex_putc(ex, '\n');
+}
+
+static void ex_bin_block(DodaExporter *ex) {
+    const Table *t = ex->table; uint16_t rows = (uint16_t)ex->npending;
+    if (rows == 0) return;
+    ex_put(ex, &rows, 2);
+    for (int i = 0; i < t->column_count; ++i) {
+        const Column *c = &t->columns[i];
+        for (size_t k = 0; k < ex->npending; ++k) {
+            size_t r = ex->pending[k];
+            switch (c->type) {
+                case COL_INT: ex_put(ex, &c->data.int_data[r], sizeof(int)); break;
+                case COL_BOOL: ex_putc(ex, (char)column_bool_get(c, r)); break;
+#ifndef DRIVERSQL_NO_FLOAT
+                case COL_FLOAT: ex_put(ex, &c->data.float_data[r], sizeof(float)); break;
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+                case COL_DOUBLE: ex_put(ex, &c->data.double_data[r], sizeof(double)); break;
+#endif
+#ifndef DRIVERSQL_NO_TEXT
+                case COL_TEXT: { size_t n = io_strnlen(c->data.text_data[r], MAX_TEXT_LEN); if (n > 255) n = 255; ex_putc(ex, (char)(uint8_t)n); ex_put(ex, c->data.text_data[r], n); break; }
+#endif
+                default: break;
+            }
+        }
+    }
+    ex->npending = 0;
+}
+
+DodaStatus doda_export_csv_begin(DodaExporter *ex, const Table *t, bool header) {
+    if (!ex || !t) return DodaStatus_ERR_INVALID;
+    if (!io_supported(t)) return DodaStatus_ERR_UNSUPPORTED;
+    ex->table = t; ex->binary = false; ex->npending = 0; ex->rows = 0;
+    if (header) {
+        for (int i = 0; i < t->column_count; ++i) { if (i) ex_putc(ex, ','); ex_put(ex, t->columns[i].name, io_strnlen(t->columns[i].name, MAX_NAME_LEN)); }
+        ex_putc(ex, '\n');
+    }
+    return DodaStatus_OK;
+}
+
+DodaStatus doda_export_bin_begin(DodaExporter *ex, const Table *t) {
+    if (!ex || !t) return DodaStatus_ERR_INVALID;
+    if (!io_supported(t)) return DodaStatus_ERR_UNSUPPORTED;
+    ex->table = t; ex->binary = true; ex->npending = 0; ex->rows = 0;
+    uint8_t hdr[10]; uint16_t ncols = (uint16_t)t->column_count, block_rows = DRIVERSQL_IO_CHUNK_ROWS;
+    memcpy(hdr, "DODB", 4); hdr[4] = DODA_IO_BIN_VERSION; hdr[5] = host_little_endian() ? 1 : 0;
+    memcpy(hdr + 6, &ncols, 2); memcpy(hdr + 8, &block_rows, 2);
+    ex_put(ex, hdr, sizeof(hdr));
+    for (int i = 0; i < t->column_count; ++i) ex_putc(ex, (char)(uint8_t)t->columns[i].type);
+    return DodaStatus_OK;
+}
+
+void doda_export_row(DodaExporter *ex, size_t row) {
+    ex->rows++;
+    if (!ex->binary) { ex_csv_row(ex, row); return; }
+    ex->pending[ex->npending++] = (uint16_t)row;
+    if (ex->npending == DRIVERSQL_IO_CHUNK_ROWS) ex_bin_block(ex);
+}
+
+void doda_export_row_cb(const Table *t, size_t row, void *user) { (void)t; doda_export_row((DodaExporter *)user, row); }
+
+DodaStatus doda_export_finish(DodaExporter *ex) {
+    if (ex->binary) { uint16_t end = 0; ex_bin_block(ex); ex_put(ex, &end, 2); }
+    ex_flush(ex);
+    return ex->error ? DodaStatus_ERR_INVALID : DodaStatus_OK;
+}
+
+static DodaStatus export_all(DodaExporter *ex, const Table *t) {
+    for (size_t r = 0; r < t->count; ++r) if (!is_deleted(t, r)) doda_export_row(ex, r);
+    return doda_export_finish(ex);
+}
+
+DodaStatus doda_export_csv_table(DodaExporter *ex, const Table *t, bool header) {
+    DodaStatus st = doda_export_csv_begin(ex, t, header); if (st != DodaStatus_OK) return st;
+    return export_all(ex, t);
+}
+
+DodaStatus doda_export_bin_table(DodaExporter *ex, const Table *t) {
+    DodaStatus st = doda_export_bin_begin(ex, t); if (st != DodaStatus_OK) return st;
+    return export_all(ex, t);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 Rohit Ballurgi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software... [rest of standard MIT short-text]
+ * ...
+ * MIT License (see LICENSE file for full text)
+ */
+#pragma once
+#include "doda_engine.h"
+
+// Streaming bulk import/export for Table.
+// Input and output go through caller-supplied read/write callbacks; all buffering lives in the
+// caller-owned DodaLoader/DodaExporter, so nothing is allocated per row (or at all).
+// Rows are staged column-major in chunks of DRIVERSQL_IO_CHUNK_ROWS and handed to insert_rows.
+//
+// CSV: one record per row, comma separated, columns in table order. Fields may be double-quoted
+// ("" escapes a quote); quoted fields may contain commas, CR and LF, so a record can span several
+// physical lines and the exporter quotes TEXT containing any of these. A record (including its
+// embedded newlines) must fit in DRIVERSQL_IO_LINE_MAX bytes; longer records, and an unterminated
+// quote at end of input, are counted as rejected. BOOL accepts 0/1/true/false. An optional header
+// line is skipped.
+//
+// Binary (native byte order, little-endian marker checked on load):
+//   header: "DODB" u8 version u8 endian(1=little) u16 column_count u16 block_rows u8 type[column_count]
+//   block:  u16 rows, then for each column `rows` values: INT i32, BOOL u8, FLOAT f32, DOUBLE f64,
+//           TEXT u8 len + bytes
+//   a block with rows == 0 ends the stream. Loaders reject block_rows > DRIVERSQL_IO_CHUNK_ROWS.
+// POINTER columns are not supported by either format.
+
+#ifndef DRIVERSQL_IO_CHUNK_ROWS
+#define DRIVERSQL_IO_CHUNK_ROWS 32
+#endif
+#ifndef DRIVERSQL_IO_BUF_SIZE
+#define DRIVERSQL_IO_BUF_SIZE 512
+#endif
+#ifndef DRIVERSQL_IO_LINE_MAX
+#define DRIVERSQL_IO_LINE_MAX 512
+#endif
+
+#define DODA_IO_BIN_VERSION 1
+
+// Return bytes transferred; a read of 0 means end of input, a short write means failure.
+typedef size_t (*doda_read_fn)(void *ctx, void *buf, size_t len);
+typedef size_t (*doda_write_fn)(void *ctx, const void *buf, size_t len);
+
+// One staged column chunk
+typedef union {
+    int i[DRIVERSQL_IO_CHUNK_ROWS];
+#ifndef DRIVERSQL_NO_FLOAT
+    float f[DRIVERSQL_IO_CHUNK_ROWS];
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+    double d[DRIVERSQL_IO_CHUNK_ROWS];
+#endif
+#ifndef DRIVERSQL_NO_TEXT
+    char s[DRIVERSQL_IO_CHUNK_ROWS][MAX_TEXT_LEN];
+#endif
+} DodaIoChunk;
+
+typedef struct {
+    Table *table;
+    doda_read_fn read;
+    void *ctx;
+    uint8_t buf[DRIVERSQL_IO_BUF_SIZE];
+    size_t buf_len, buf_pos;
+    char line[DRIVERSQL_IO_LINE_MAX];
+    size_t line_len;
+    uint8_t csv_state; // CSV record scanner state; newlines inside a quoted field do not end the record
+    DodaIoChunk chunk[MAX_COLUMNS];
+    size_t staged;
+    size_t loaded;   // rows stored in the table
+    size_t rejected; // rows that failed to parse, duplicated a PK or did not fit
+    size_t lines;    // records read, including the header
+} DodaLoader;
+
+typedef struct {
+    doda_write_fn write;
+    void *ctx;
+    uint8_t buf[DRIVERSQL_IO_BUF_SIZE];
+    size_t len;
+    const Table *table;
+    uint16_t pending[DRIVERSQL_IO_CHUNK_ROWS]; // binary: rows waiting for the next block
+    size_t npending;
+    bool binary;
+    bool error;
+    size_t rows;
+} DodaExporter;
+
+void doda_loader_init(DodaLoader *ld, Table *t, doda_read_fn rd, void *ctx);
+DodaStatus doda_load_csv(DodaLoader *ld, bool has_header);
+DodaStatus doda_load_bin(DodaLoader *ld);
+
+// Exporters: begin, feed rows (directly or as a row_callback to select_where_op / index_select_op
+// with the exporter as user pointer), then finish to flush. finish returns DodaStatus_ERR_INVALID
+// if any write callback stored fewer bytes than requested; the output is then incomplete.
+void doda_export_init(DodaExporter *ex, doda_write_fn wr, void *ctx);
+DodaStatus doda_export_csv_begin(DodaExporter *ex, const Table *t, bool header);
+DodaStatus doda_export_bin_begin(DodaExporter *ex, const Table *t);
+void doda_export_row(DodaExporter *ex, size_t row);
+void doda_export_row_cb(const Table *t, size_t row, void *user);
+DodaStatus doda_export_finish(DodaExporter *ex);
+// Whole-table convenience wrappers
+DodaStatus doda_export_csv_table(DodaExporter *ex, const Table *t, bool header);
+DodaStatus doda_export_bin_table(DodaExporter *ex, const Table *t);
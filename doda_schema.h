@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 Rohit Ballurgi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software... [rest of standard MIT short-text]
+ * ...
+ * MIT License (see LICENSE file for full text)
+ */
+#pragma once
+#include "doda_engine.h"
+#include <string.h>
+
+// Compile-time schema specialization. Describe a fixed schema as an X-macro and let
+// DODA_SCHEMA emit a typed row struct plus insert/get/select/aggregate functions with
+// no ColumnType switches and no void-pointer marshalling. Storage is a plain Table, so
+// the deleted bitmap, free list and PK hash are shared with the generic API.
+//
+//   #define METRICS_SCHEMA(X, ctx) X(ctx, id, INT) X(ctx, time, INT) X(ctx, value, FLOAT)
+//   DODA_SCHEMA(metrics, METRICS_SCHEMA)
+//
+// generates:
+//   metrics_row                      struct { int id; int time; float value; }
+//   metrics_COL_<field>              column positions, metrics_COLUMN_COUNT
+//   metrics_init(Table*, name)       init_table with the schema's names/types
+//   metrics_insert(Table*, const metrics_row*)
+//   metrics_get(const Table*, row, metrics_row*)
+//   metrics_select_<field>(const Table*, Op, key, row_callback, user) -> matches
+//   metrics_agg_<field>(const Table*, DodaAgg<KIND>*)   (INT/FLOAT/DOUBLE fields)
+//
+// Kinds: INT, BOOL, FLOAT, DOUBLE, TEXT (subject to the usual feature gates).
+// The first field is the primary key and must be INT.
+
+// Live rows of 64-row block w: not deleted and below t->count
+static inline uint64_t doda_sk_live_mask(const Table *t, size_t w, size_t lim) {
+    uint64_t live = ~t->deleted_bits[w]; return lim < 64 ? live & ((1ULL << lim) - 1) : live;
+}
+
+static inline size_t doda_sk_emit(const Table *t, size_t base, uint64_t m, row_callback cb, void *user) {
+    size_t n = 0; while (m) { size_t r = base + DODA_CTZ64(m); m &= m - 1; if (cb) cb(t, r, user); n++; } return n;
+}
+
+// Per-kind traits: C type, ColumnType and store/load/match helpers
+#define DODA_SK_CTYPE_INT int
+#define DODA_SK_COLTYPE_INT COL_INT
+#define DODA_SK_CTYPE_BOOL bool
+#define DODA_SK_COLTYPE_BOOL COL_BOOL
+#define DODA_SK_CTYPE_FLOAT float
+#define DODA_SK_COLTYPE_FLOAT COL_FLOAT
+#define DODA_SK_CTYPE_DOUBLE double
+#define DODA_SK_COLTYPE_DOUBLE COL_DOUBLE
+#define DODA_SK_CTYPE_TEXT const char *
+#define DODA_SK_COLTYPE_TEXT COL_TEXT
+
+// Builds a 64-row match mask with a branch-free loop per operator so the compiler can vectorize it
+#define DODA_SK_MATCH_LOOPS(load_expr, key)                                                                  \
+    uint64_t m = 0;                                                                                          \
+    switch (op) {                                                                                            \
+        case OP_EQ:  for (size_t b = 0; b < lim; ++b) m |= (uint64_t)((load_expr) == (key)) << b; break;    \
+        case OP_GT:  for (size_t b = 0; b < lim; ++b) m |= (uint64_t)((load_expr) > (key)) << b; break;     \
+        case OP_LT:  for (size_t b = 0; b < lim; ++b) m |= (uint64_t)((load_expr) < (key)) << b; break;     \
+        case OP_GTE: for (size_t b = 0; b < lim; ++b) m |= (uint64_t)((load_expr) >= (key)) << b; break;    \
+    }                                                                                                        \
+    return m;
+
+#define DODA_SK_DEFINE_NUMERIC(KIND, ctype, member, sum_t)                                                   \
+    typedef struct { size_t count; sum_t sum; ctype min; ctype max; } DodaAgg##KIND;                         \
+    static inline void doda_sk_store_##KIND(Column *c, size_t row, ctype v) { c->data.member[row] = v; }    \
+    static inline ctype doda_sk_load_##KIND(const Column *c, size_t row) { return c->data.member[row]; }    \
+    static inline uint64_t doda_sk_match_##KIND(const Column *c, size_t base, size_t lim, Op op, ctype key) { \
+        const ctype *v = &c->data.member[base]; DODA_SK_MATCH_LOOPS(v[b], key)                               \
+    }                                                                                                        \
+    static inline bool doda_sk_agg_##KIND(const Table *t, const Column *c, DodaAgg##KIND *out) {             \
+        out->count = 0; out->sum = 0; out->min = 0; out->max = 0;                                            \
+        for (size_t w = 0; w * 64 < t->count; ++w) {                                                         \
+            size_t base = w * 64, lim = t->count - base < 64 ? t->count - base : 64;                         \
+            uint64_t live = doda_sk_live_mask(t, w, lim);                                                    \
+            for (size_t b = 0; b < lim; ++b) {                                                               \
+                if (!((live >> b) & 1ULL)) continue;                                                         \
+                ctype v = c->data.member[base + b];                                                          \
+                if (out->count == 0 || v < out->min) out->min = v;                                          \
+                if (out->count == 0 || v > out->max) out->max = v;                                          \
+                out->sum += (sum_t)v; out->count++;                                                          \
+            }                                                                                                \
+        }                                                                                                    \
+        return out->count > 0;                                                                               \
+    }
+
+DODA_SK_DEFINE_NUMERIC(INT, int, int_data, long long)
+#ifndef DRIVERSQL_NO_FLOAT
+DODA_SK_DEFINE_NUMERIC(FLOAT, float, float_data, double)
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+DODA_SK_DEFINE_NUMERIC(DOUBLE, double, double_data, double)
+#endif
+
+static inline void doda_sk_store_BOOL(Column *c, size_t row, bool v) { column_bool_set(c, row, v); }
+static inline bool doda_sk_load_BOOL(const Column *c, size_t row) { return column_bool_get(c, row); }
+// BOOL is already packed: base is word aligned and the caller masks rows >= lim
+static inline uint64_t doda_sk_match_BOOL(const Column *c, size_t base, size_t lim, Op op, bool key) {
+    (void)lim; return bool_match_word(c->data.bool_bits[base / 64], op, key);
+}
+
+#ifndef DRIVERSQL_NO_TEXT
+static inline void doda_sk_store_TEXT(Column *c, size_t row, const char *v) {
+    strncpy(c->data.text_data[row], v ? v : "", MAX_TEXT_LEN - 1); c->data.text_data[row][MAX_TEXT_LEN - 1] = '\0';
+}
+static inline const char *doda_sk_load_TEXT(const Column *c, size_t row) { return c->data.text_data[row]; }
+static inline uint64_t doda_sk_match_TEXT(const Column *c, size_t base, size_t lim, Op op, const char *key) {
+    DODA_SK_MATCH_LOOPS(strncmp(c->data.text_data[base + b], key, MAX_TEXT_LEN), 0)
+}
+#endif
+
+// Per-field generators, expanded through the user's X-macro
+#define DODA_SK_ENUM(name, field, KIND) name##_COL_##field,
+#define DODA_SK_MEMBER(name, field, KIND) DODA_SK_CTYPE_##KIND field;
+#define DODA_SK_NAME(name, field, KIND) #field,
+#define DODA_SK_TYPE(name, field, KIND) DODA_SK_COLTYPE_##KIND,
+#define DODA_SK_STORE(name, field, KIND) doda_sk_store_##KIND(&t->columns[name##_COL_##field], row, r->field);
+#define DODA_SK_LOAD(name, field, KIND) out->field = doda_sk_load_##KIND(&t->columns[name##_COL_##field], row);
+
+#define DODA_SK_SELECT(name, field, KIND)                                                                    \
+    static inline size_t name##_select_##field(const Table *t, Op op, DODA_SK_CTYPE_##KIND key, row_callback cb, void *user) { \
+        const Column *c = &t->columns[name##_COL_##field]; size_t n = 0;                                    \
+        for (size_t w = 0; w * 64 < t->count; ++w) {                                                         \
+            size_t base = w * 64, lim = t->count - base < 64 ? t->count - base : 64;                         \
+            uint64_t m = doda_sk_match_##KIND(c, base, lim, op, key) & doda_sk_live_mask(t, w, lim);         \
+            n += doda_sk_emit(t, base, m, cb, user);                                                         \
+        }                                                                                                    \
+        return n;                                                                                            \
+    }
+
+#define DODA_SK_AGG_FN(name, field, KIND)                                                                    \
+    static inline bool name##_agg_##field(const Table *t, DodaAgg##KIND *out) {                              \
+        return doda_sk_agg_##KIND(t, &t->columns[name##_COL_##field], out);                                  \
+    }
+#define DODA_SK_AGG_INT(name, field) DODA_SK_AGG_FN(name, field, INT)
+#define DODA_SK_AGG_FLOAT(name, field) DODA_SK_AGG_FN(name, field, FLOAT)
+#define DODA_SK_AGG_DOUBLE(name, field) DODA_SK_AGG_FN(name, field, DOUBLE)
+#define DODA_SK_AGG_BOOL(name, field)
+#define DODA_SK_AGG_TEXT(name, field)
+#define DODA_SK_AGG(name, field, KIND) DODA_SK_AGG_##KIND(name, field)
+
+#define DODA_SCHEMA(name, SCHEMA)                                                                            \
+    enum { SCHEMA(DODA_SK_ENUM, name) name##_COLUMN_COUNT };                                                 \
+    typedef struct { SCHEMA(DODA_SK_MEMBER, name) } name##_row;                                              \
+    static inline void name##_init(Table *t, const char *table_name) {                                       \
+        static const char *names[] = { SCHEMA(DODA_SK_NAME, name) };                                         \
+        static const ColumnType types[] = { SCHEMA(DODA_SK_TYPE, name) };                                    \
+        init_table(t, table_name, name##_COLUMN_COUNT, names, types);                                        \
+    }                                                                                                        \
+    static inline DSStatus name##_insert(Table *t, const name##_row *r) {                                    \
+        size_t row; DSStatus st = table_reserve_row(t, &row); if (st != DS_OK) return st;                    \
+        SCHEMA(DODA_SK_STORE, name)                                                                          \
+        return table_commit_row(t, row);                                                                     \
+    }                                                                                                        \
+    static inline bool name##_get(const Table *t, size_t row, name##_row *out) {                             \
+        if (row >= t->count || is_deleted(t, row)) return false;                                             \
+        SCHEMA(DODA_SK_LOAD, name)                                                                           \
+        return true;                                                                                         \
+    }                                                                                                        \
+    SCHEMA(DODA_SK_SELECT, name)                                                                             \
+    SCHEMA(DODA_SK_AGG, name)
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2025 Rohit Ballurgi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software... [rest of standard MIT short-text]
+ * ...
+ * MIT License (see LICENSE file for full text)
+ */
+#define _POSIX_C_SOURCE 200112L
+#include "doda_shm.h"
+
+#ifdef DRIVERSQL_SHM
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SHM_LOAD_ACQ(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SHM_STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define SHM_FENCE_ACQ() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define SHM_FENCE_REL() __atomic_thread_fence(__ATOMIC_RELEASE)
+#else
+#error "doda_shm requires GCC/Clang atomic builtins"
+#endif
+
+static uint32_t shm_config_fingerprint(void) {
+    uint32_t h = 2166136261u;
+    const uint32_t parts[] = {
+        MAX_ROWS, MAX_COLUMNS, MAX_NAME_LEN, MAX_TEXT_LEN, HASH_SIZE, DRIVERSQL_GROUP_MAX, DRIVERSQL_GROUP_HASH_SIZE,
+        DRIVERSQL_SHM_MAX_INDEXES, DRIVERSQL_SHM_MAX_ROLLUPS,
+#ifdef DRIVERSQL_NO_TEXT
+        0x100u |
+#endif
+#ifdef DRIVERSQL_NO_FLOAT
+        0x200u |
+#endif
+#ifdef DRIVERSQL_NO_DOUBLE
+        0x400u |
+#endif
+#ifdef DRIVERSQL_NO_POINTER_COLUMN
+        0x800u |
+#endif
+        0u
+    };
+    for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); ++i) { h ^= parts[i]; h *= 16777619u; }
+    return h;
+}
+
+DodaStatus doda_shm_create(DodaShm *shm, const char *name, const char *table_name, int column_count, const char **col_names, const DodaColumnType *col_types) {
+    if (!shm || !name || column_count <= 0 || column_count > MAX_COLUMNS) return DodaStatus_ERR_INVALID;
+#ifndef DRIVERSQL_NO_POINTER_COLUMN
+    for (int i = 0; i < column_count; ++i) if (col_types && col_types[i] == COL_POINTER) return DodaStatus_ERR_UNSUPPORTED;
+#endif
+    shm->seg = NULL; shm->writable = true;
+    // Replace rather than truncate: shrinking an object that readers have mapped makes their next access SIGBUS
+    shm_unlink(name);
+    shm->fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644); if (shm->fd < 0) return DodaStatus_ERR_NOT_FOUND;
+    if (ftruncate(shm->fd, (off_t)sizeof(DodaShmSegment)) != 0) { close(shm->fd); shm->fd = -1; shm_unlink(name); return DodaStatus_ERR_FULL; }
+    void *p = mmap(NULL, sizeof(DodaShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);
+    if (p == MAP_FAILED) { close(shm->fd); shm->fd = -1; shm_unlink(name); return DodaStatus_ERR_FULL; }
+    shm->seg = (DodaShmSegment *)p;
+    DodaShmSegment *s = shm->seg;
+    s->seq = 0; s->config = shm_config_fingerprint(); s->table_size = (uint32_t)sizeof(Table); s->version = DODA_SHM_LAYOUT_VERSION;
+    doda_init_table(&s->table, table_name, column_count, col_names, col_types);
+    for (size_t i = 0; i < DRIVERSQL_SHM_MAX_INDEXES; ++i) doda_index_drop(&s->indexes[i]);
+    SHM_STORE_REL(&s->magic, DODA_SHM_MAGIC); // published last: readers never see a half-initialized header
+    return DodaStatus_OK;
+}
+
+DodaStatus doda_shm_attach(DodaShm *shm, const char *name) {
+    if (!shm || !name) return DodaStatus_ERR_INVALID;
+    shm->seg = NULL; shm->writable = false;
+    shm->fd = shm_open(name, O_RDONLY, 0); if (shm->fd < 0) return DodaStatus_ERR_NOT_FOUND;
+    struct stat st;
+    if (fstat(shm->fd, &st) != 0 || (size_t)st.st_size != sizeof(DodaShmSegment)) { close(shm->fd); shm->fd = -1; return DodaStatus_ERR_INVALID; }
+    void *p = mmap(NULL, sizeof(DodaShmSegment), PROT_READ, MAP_SHARED, shm->fd, 0);
+    if (p == MAP_FAILED) { close(shm->fd); shm->fd = -1; return DodaStatus_ERR_INVALID; }
+    shm->seg = (DodaShmSegment *)p;
+    const DodaShmSegment *s = shm->seg;
+    if (SHM_LOAD_ACQ(&s->magic) != DODA_SHM_MAGIC || s->version != DODA_SHM_LAYOUT_VERSION || s->config != shm_config_fingerprint() || s->table_size != sizeof(Table)) {
+        doda_shm_detach(shm); return DodaStatus_ERR_INVALID;
+    }
+    return DodaStatus_OK;
+}
+
+void doda_shm_detach(DodaShm *shm) {
+    if (!shm) return;
+    if (shm->seg) munmap(shm->seg, sizeof(DodaShmSegment));
+    if (shm->fd >= 0) close(shm->fd);
+    shm->seg = NULL; shm->fd = -1;
+}
+
+DodaStatus doda_shm_unlink(const char *name) { return (name && shm_unlink(name) == 0) ? DodaStatus_OK : DodaStatus_ERR_NOT_FOUND; }
+
+DodaStatus doda_shm_write_begin(DodaShm *shm) {
+    if (!shm || !shm->seg) return DodaStatus_ERR_INVALID;
+    if (!shm->writable) return DodaStatus_ERR_UNSUPPORTED;
+    uint32_t s = shm->seg->seq; __atomic_store_n(&shm->seg->seq, s + 1, __ATOMIC_RELAXED); SHM_FENCE_REL();
+    return DodaStatus_OK;
+}
+
+DodaStatus doda_shm_write_end(DodaShm *shm) {
+    if (!shm || !shm->seg) return DodaStatus_ERR_INVALID;
+    if (!shm->writable) return DodaStatus_ERR_UNSUPPORTED;
+    SHM_STORE_REL(&shm->seg->seq, shm->seg->seq + 1); return DodaStatus_OK;
+}
+
+DodaStatus doda_shm_read_begin(const DodaShm *shm, uint32_t *seq) {
+    for (uint32_t i = 0; i < DRIVERSQL_SHM_READ_SPINS; ++i) {
+        uint32_t s = SHM_LOAD_ACQ(&shm->seg->seq);
+        if (!(s & 1u)) { *seq = s; return DodaStatus_OK; }
+        if (i >= 64) sched_yield(); // writer active: spin briefly, then give up the CPU
+    }
+    return DodaStatus_ERR_INVALID;
+}
+
+bool doda_shm_read_retry(const DodaShm *shm, uint32_t seq) {
+    SHM_FENCE_ACQ(); return __atomic_load_n(&shm->seg->seq, __ATOMIC_RELAXED) != seq;
+}
+
+#endif // DRIVERSQL_SHM
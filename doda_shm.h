@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 Rohit Ballurgi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software... [rest of standard MIT short-text]
+ * ...
+ * MIT License (see LICENSE file for full text)
+ */
+#pragma once
+#include "doda_engine.h"
+
+// Enable this module with -DDRIVERSQL_SHM (POSIX hosts only)
+#ifdef DRIVERSQL_SHM
+
+// Shared-memory Table for cross-process zero-copy readers.
+// The segment holds a header, the Table, optional Indexes and GROUP BY rollups. All of these are
+// fixed-size arrays addressed by row number, so the layout is position independent and readers
+// can run select_where_op / index_select_op / agg_* directly on the mapping.
+// Pointer columns are rejected because their values are meaningless in another process.
+//
+// Consistency uses a sequence lock: the single writer brackets mutations with
+// doda_shm_write_begin/end; readers take doda_shm_read_begin, run their query and discard the
+// results if doda_shm_read_retry returns true. If the writer dies between write_begin and write_end
+// the sequence stays odd: read_begin then gives up after DRIVERSQL_SHM_READ_SPINS attempts and
+// returns DodaStatus_ERR_INVALID, and the segment must be recreated.
+//
+// Readers map the segment PROT_READ: doda_shm_table/index/rollup return const pointers, and the
+// _mut accessors and write_begin/end are only valid on the handle returned by doda_shm_create.
+
+#ifndef DRIVERSQL_SHM_MAX_INDEXES
+#define DRIVERSQL_SHM_MAX_INDEXES 2
+#endif
+#ifndef DRIVERSQL_SHM_MAX_ROLLUPS
+#define DRIVERSQL_SHM_MAX_ROLLUPS 1
+#endif
+#ifndef DRIVERSQL_SHM_READ_SPINS
+#define DRIVERSQL_SHM_READ_SPINS 100000u // read_begin attempts (yielding after the first 64)
+#endif
+
+#define DODA_SHM_MAGIC 0x41444F44u // "DODA"
+#define DODA_SHM_LAYOUT_VERSION 3u // 2: BOOL columns packed into bool_bits; 3: Table.generation
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;    // DODA_SHM_LAYOUT_VERSION
+    uint32_t config;     // fingerprint of capacity macros and feature gates
+    uint32_t table_size; // sizeof(Table), catches ABI differences (e.g. 32/64-bit)
+    uint32_t seq;        // odd while the writer is mutating
+    uint32_t reserved;
+    Table table;
+    Index indexes[DRIVERSQL_SHM_MAX_INDEXES];
+    GroupBy rollups[DRIVERSQL_SHM_MAX_ROLLUPS];
+} DodaShmSegment;
+
+typedef struct {
+    DodaShmSegment *seg;
+    int fd;
+    bool writable; // created by doda_shm_create; attached readers are read-only
+} DodaShm;
+
+// Writer: create segment `name` (e.g. "/doda_metrics") and initialize its Table. An existing segment
+// with that name is unlinked first, never truncated: readers still attached keep the old object
+// mapped (and stale) until they detach and attach again.
+DodaStatus doda_shm_create(DodaShm *shm, const char *name, const char *table_name, int column_count, const char **col_names, const DodaColumnType *col_types);
+// Reader: map read-only; DodaStatus_ERR_INVALID on magic/version/config mismatch.
+DodaStatus doda_shm_attach(DodaShm *shm, const char *name);
+void doda_shm_detach(DodaShm *shm);
+DodaStatus doda_shm_unlink(const char *name);
+
+// Both return DodaStatus_ERR_UNSUPPORTED on a reader handle.
+DodaStatus doda_shm_write_begin(DodaShm *shm);
+DodaStatus doda_shm_write_end(DodaShm *shm);
+DodaStatus doda_shm_read_begin(const DodaShm *shm, uint32_t *seq);
+bool doda_shm_read_retry(const DodaShm *shm, uint32_t seq);
+
+static inline const DodaTable *doda_shm_table(const DodaShm *shm) { return &shm->seg->table; }
+static inline const DodaIndex *doda_shm_index(const DodaShm *shm, size_t i) { return i < DRIVERSQL_SHM_MAX_INDEXES ? &shm->seg->indexes[i] : NULL; }
+static inline const DodaGroupBy *doda_shm_rollup(const DodaShm *shm, size_t i) { return i < DRIVERSQL_SHM_MAX_ROLLUPS ? &shm->seg->rollups[i] : NULL; }
+// Writer-side mutable access; NULL on a reader handle
+static inline DodaTable *doda_shm_table_mut(DodaShm *shm) { return shm->writable ? &shm->seg->table : NULL; }
+static inline DodaIndex *doda_shm_index_mut(DodaShm *shm, size_t i) { return shm->writable && i < DRIVERSQL_SHM_MAX_INDEXES ? &shm->seg->indexes[i] : NULL; }
+static inline DodaGroupBy *doda_shm_rollup_mut(DodaShm *shm, size_t i) { return shm->writable && i < DRIVERSQL_SHM_MAX_ROLLUPS ? &shm->seg->rollups[i] : NULL; }
+
+#endif // DRIVERSQL_SHM
@@ -8,15 +8,19 @@
  */
 
 #include "doda_api.h"
+#include <string.h>
 
 #ifdef DRIVERSQL_TIMESERIES
 
 void doda_tsdb_init(DodaTSDB *ts, DodaTable *t, const char *time_col) {
-    ts->table = t; ts->time_col = time_col;
+    ts->table = t; ts->time_col = time_col; ts->window_count = 0;
 }
 
 DodaStatus doda_tsdb_append_int3(DodaTSDB *ts, int id, int time, int value) {
-    const void *vals[3]; vals[0] = &id; vals[1] = &time; vals[2] = &value; return doda_insert_row(ts->table, vals);
+    const void *vals[3]; vals[0] = &id; vals[1] = &time; vals[2] = &value;
+    DodaStatus st = doda_insert_row(ts->table, vals); if (st != DodaStatus_OK) return st;
+    for (size_t i = 0; i < ts->window_count; ++i) doda_window_push(ts->windows[i], time, *(const int *)vals[ts->windows[i]->col]);
+    return DodaStatus_OK;
 }
 
 DodaStatus doda_tsdb_select_time_ge(const DodaTSDB *ts, int t0, doda_row_callback cb, void *user) {
@@ -37,12 +41,171 @@ DodaStatus doda_tsdb_delete_older_than(DodaTSDB *ts, int cutoff_time, size_t *de
         if (doda_is_deleted(ts->table, r)) continue;
         int v = ts->table->columns[col].data.int_data[r];
         if (v < cutoff_time) {
-            ts->table->free_list[ts->table->free_top++] = (uint16_t)r;
-            ts->table->deleted_bits[r/64] |= (1ULL << (r%64));
+            table_delete_row(ts->table, r);
             del++;
         }
     }
+    for (size_t i = 0; i < ts->window_count; ++i) doda_window_evict_before(ts->windows[i], cutoff_time);
     if (deleted_out) *deleted_out = del; return DodaStatus_OK;
 }
 
+#define WIN_MASK (DRIVERSQL_WINDOW_MAX - 1)
+
+DodaStatus doda_window_init(DodaWindow *w, DodaWindowKind kind, int size, double ewma_alpha) {
+    if (!w || size <= 0 || (kind == DODA_WIN_COUNT && size > DRIVERSQL_WINDOW_MAX)) return DodaStatus_ERR_INVALID;
+    memset(w, 0, sizeof(*w));
+    w->kind = kind; w->size = size; w->col = -1; w->alpha = ewma_alpha;
+    return DodaStatus_OK;
+}
+
+static void window_pop_front(DodaWindow *w) {
+    uint32_t s = w->head++;
+    w->sum -= w->values[s & WIN_MASK];
+    if (w->min_head != w->min_tail && w->min_q[w->min_head & WIN_MASK] == s) w->min_head++;
+    if (w->max_head != w->max_tail && w->max_q[w->max_head & WIN_MASK] == s) w->max_head++;
+}
+
+void doda_window_push(DodaWindow *w, int time, int value) {
+    if (w->kind == DODA_WIN_COUNT) { while (w->tail - w->head >= (uint32_t)w->size) window_pop_front(w); }
+    else { while (w->tail != w->head && (long long)w->times[w->head & WIN_MASK] <= (long long)time - w->size) window_pop_front(w); }
+    if (w->tail - w->head >= DRIVERSQL_WINDOW_MAX) window_pop_front(w);
+    uint32_t s = w->tail++;
+    w->times[s & WIN_MASK] = time; w->values[s & WIN_MASK] = value; w->sum += value;
+    while (w->min_tail != w->min_head && w->values[w->min_q[(w->min_tail - 1) & WIN_MASK] & WIN_MASK] >= value) w->min_tail--;
+    w->min_q[w->min_tail++ & WIN_MASK] = s;
+    while (w->max_tail != w->max_head && w->values[w->max_q[(w->max_tail - 1) & WIN_MASK] & WIN_MASK] <= value) w->max_tail--;
+    w->max_q[w->max_tail++ & WIN_MASK] = s;
+    if (w->alpha > 0.0) { w->ewma = w->ewma_valid ? w->alpha * value + (1.0 - w->alpha) * w->ewma : (double)value; w->ewma_valid = true; }
+}
+
+void doda_window_evict_before(DodaWindow *w, int cutoff) {
+    while (w->tail != w->head && w->times[w->head & WIN_MASK] < cutoff) window_pop_front(w);
+}
+
+size_t doda_window_count(const DodaWindow *w) { return (size_t)(w->tail - w->head); }
+
+bool doda_window_sum(const DodaWindow *w, long long *out) { if (w->tail == w->head) return false; *out = w->sum; return true; }
+bool doda_window_avg(const DodaWindow *w, double *out) { if (w->tail == w->head) return false; *out = (double)w->sum / (double)(w->tail - w->head); return true; }
+bool doda_window_min(const DodaWindow *w, int *out) { if (w->tail == w->head) return false; *out = w->values[w->min_q[w->min_head & WIN_MASK] & WIN_MASK]; return true; }
+bool doda_window_max(const DodaWindow *w, int *out) { if (w->tail == w->head) return false; *out = w->values[w->max_q[w->max_head & WIN_MASK] & WIN_MASK]; return true; }
+
+bool doda_window_delta(const DodaWindow *w, int *out) {
+    if (w->tail == w->head) return false;
+    *out = w->values[(w->tail - 1) & WIN_MASK] - w->values[w->head & WIN_MASK]; return true;
+}
+
+bool doda_window_rate(const DodaWindow *w, double *out) {
+    if (w->tail - w->head < 2) return false;
+    long long dt = (long long)w->times[(w->tail - 1) & WIN_MASK] - w->times[w->head & WIN_MASK]; if (dt == 0) return false;
+    *out = ((double)w->values[(w->tail - 1) & WIN_MASK] - w->values[w->head & WIN_MASK]) / (double)dt; return true;
+}
+
+bool doda_window_ewma(const DodaWindow *w, double *out) { if (!w->ewma_valid) return false; *out = w->ewma; return true; }
+
+DodaStatus doda_tsdb_attach_window(DodaTSDB *ts, DodaWindow *w, const char *col_name) {
+    if (!ts || !w || !col_name) return DodaStatus_ERR_INVALID;
+    int col = doda_column_index(ts->table, col_name); if (col < 0) return DodaStatus_ERR_NOT_FOUND;
+    if (col > 2 || ts->table->columns[col].type != COL_INT) return DodaStatus_ERR_UNSUPPORTED; // append_int3 schema
+    if (ts->window_count >= DRIVERSQL_TS_MAX_WINDOWS) return DodaStatus_ERR_FULL;
+    w->col = col; ts->windows[ts->window_count++] = w; return DodaStatus_OK;
+}
+
+// Time-ordered walk over one side of a join: Index order if given, else physical order
+typedef struct {
+    const DodaTable *t;
+    const DodaIndex *idx;
+    int col;
+    size_t pos, end;
+} TsCursor;
+
+static DodaStatus ts_cursor_init(TsCursor *c, const DodaTSDB *ts, const DodaIndex *idx) {
+    if (!ts || !ts->table) return DodaStatus_ERR_INVALID;
+    c->t = ts->table; c->idx = idx; c->pos = 0;
+    c->col = doda_column_index(c->t, ts->time_col); if (c->col < 0) return DodaStatus_ERR_NOT_FOUND;
+    if (c->t->columns[c->col].type != COL_INT) return DodaStatus_ERR_UNSUPPORTED;
+    if (idx) { if (!idx->active || idx->column_id != c->col) return DodaStatus_ERR_INVALID; c->end = idx->size; return DodaStatus_OK; }
+    c->end = c->t->count;
+    bool any = false; int last = 0;
+    for (size_t r = 0; r < c->end; ++r) {
+        if (doda_is_deleted(c->t, r)) continue;
+        int v = c->t->columns[c->col].data.int_data[r];
+        if (any && v < last) return DodaStatus_ERR_INVALID;
+        last = v; any = true;
+    }
+    return DodaStatus_OK;
+}
+
+static bool ts_cursor_peek(TsCursor *c, size_t *row) {
+    for (; c->pos < c->end; ++c->pos) {
+        size_t r = c->idx ? c->idx->rows[c->pos] : c->pos;
+        if (!doda_is_deleted(c->t, r)) { *row = r; return true; }
+    }
+    return false;
+}
+
+static inline int ts_cursor_time(const TsCursor *c, size_t row) { return c->t->columns[c->col].data.int_data[row]; }
+
+// Advance right past every row with time <= t; returns the last such row or DODA_NO_ROW
+static size_t ts_cursor_seek_le(TsCursor *c, int t, size_t prev) {
+    size_t r; while (ts_cursor_peek(c, &r) && ts_cursor_time(c, r) <= t) { prev = r; c->pos++; } return prev;
+}
+
+DodaStatus doda_tsdb_asof_join(const DodaTSDB *left, const DodaIndex *lidx, const DodaTSDB *right, const DodaIndex *ridx, int tolerance, doda_asof_callback cb, void *user) {
+    if (!cb) return DodaStatus_ERR_INVALID;
+    TsCursor lc, rc; DodaStatus st;
+    if ((st = ts_cursor_init(&lc, left, lidx)) != DodaStatus_OK) return st;
+    if ((st = ts_cursor_init(&rc, right, ridx)) != DodaStatus_OK) return st;
+    size_t l, prev = DODA_NO_ROW;
+    for (; ts_cursor_peek(&lc, &l); lc.pos++) {
+        int lt = ts_cursor_time(&lc, l);
+        prev = ts_cursor_seek_le(&rc, lt, prev);
+        size_t match = prev;
+        if (match != DODA_NO_ROW && tolerance >= 0 && (long long)lt - ts_cursor_time(&rc, match) > tolerance) match = DODA_NO_ROW;
+        cb(lc.t, l, rc.t, match, user);
+    }
+    return DodaStatus_OK;
+}
+
+static double ts_value_as_double(const Column *c, size_t row) {
+    switch (c->type) {
+        case COL_INT: return (double)c->data.int_data[row];
+#ifndef DRIVERSQL_NO_FLOAT
+        case COL_FLOAT: return (double)c->data.float_data[row];
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+        case COL_DOUBLE: return c->data.double_data[row];
+#endif
+        default: return 0.0;
+    }
+}
+
+DodaStatus doda_tsdb_asof_interp(const DodaTSDB *left, const DodaIndex *lidx, const DodaTSDB *right, const DodaIndex *ridx, const char *value_col, doda_interp_callback cb, void *user) {
+    if (!cb || !value_col) return DodaStatus_ERR_INVALID;
+    TsCursor lc, rc; DodaStatus st;
+    if ((st = ts_cursor_init(&lc, left, lidx)) != DodaStatus_OK) return st;
+    if ((st = ts_cursor_init(&rc, right, ridx)) != DodaStatus_OK) return st;
+    int vcol = doda_column_index(rc.t, value_col); if (vcol < 0) return DodaStatus_ERR_NOT_FOUND;
+    const Column *vc = &rc.t->columns[vcol];
+    bool numeric = vc->type == COL_INT;
+#ifndef DRIVERSQL_NO_FLOAT
+    numeric = numeric || vc->type == COL_FLOAT;
+#endif
+#ifndef DRIVERSQL_NO_DOUBLE
+    numeric = numeric || vc->type == COL_DOUBLE;
+#endif
+    if (!numeric) return DodaStatus_ERR_UNSUPPORTED;
+    size_t l, next, prev = DODA_NO_ROW;
+    for (; ts_cursor_peek(&lc, &l); lc.pos++) {
+        int lt = ts_cursor_time(&lc, l);
+        prev = ts_cursor_seek_le(&rc, lt, prev);
+        if (prev == DODA_NO_ROW) continue;
+        int pt = ts_cursor_time(&rc, prev); double pv = ts_value_as_double(vc, prev);
+        if (pt == lt) { cb(lc.t, l, pv, user); continue; }
+        if (!ts_cursor_peek(&rc, &next)) continue;
+        int nt = ts_cursor_time(&rc, next); double nv = ts_value_as_double(vc, next);
+        cb(lc.t, l, pv + (nv - pv) * ((double)lt - pt) / ((double)nt - pt), user);
+    }
+    return DodaStatus_OK;
+}
+
 #endif // DRIVERSQL_TIMESERIES
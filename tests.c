@@ -10,12 +10,20 @@
 #ifdef DRIVERSQL_TIMESERIES
 #include "doda_api.h"
 #endif
+#include "doda_schema.h"
+#include "doda_io.h"
+#ifdef DRIVERSQL_SHM
+#include "doda_shm.h"
+#endif
 #include <stdio.h>
+#include <string.h>
 
 static void print_cb(const DodaTable *tab, size_t row, void *user) {
     (void)user; doda_print_row(tab, row);
 }
 
+static void count_cb(const DodaTable *tab, size_t row, void *user) { (void)tab; (void)row; ++*(size_t *)user; }
+
 static void test_basic(void) {
     const char *cols[] = {"id", "name", "age"};
     DodaColumnType types[] = {COL_INT, COL_TEXT, COL_INT};
@@ -30,6 +38,32 @@ static void test_basic(void) {
     printf("Deleted: %zu\n", deleted);
 }
 
+// PK hash deletion: re-insert after delete, deletes inside probe chains, free-list slot reuse
+static void test_pk_delete(void) {
+    const char *cols[] = {"id", "value"};
+    DodaColumnType types[] = {COL_INT, COL_INT};
+    DodaTable t; doda_init_table(&t, "pk", 2, cols, types);
+    int id = 7, v = 1; const void *vals[] = {&id, &v};
+    doda_insert_row(&t, vals);
+    size_t d = 0; doda_delete_where_eq(&t, "id", &id, &d);
+    v = 2; DodaStatus st = doda_insert_row(&t, vals);
+    size_t n = 0; doda_select_where_eq(&t, "id", &id, count_cb, &n);
+    printf("pk reinsert: deleted=%zu status=%d found=%zu\n", d, (int)st, n);
+
+    // Fill every slot so the hash holds long probe chains, then delete every third key
+    doda_init_table(&t, "pk", 2, cols, types);
+    for (size_t i = 0; i < MAX_ROWS; ++i) { id = (int)i * 7 + 1; v = (int)i; doda_insert_row(&t, vals); }
+    size_t del = 0, bad = 0;
+    for (size_t i = 0; i < MAX_ROWS; i += 3) { id = (int)i * 7 + 1; d = 0; doda_delete_where_eq(&t, "id", &id, &d); del += d; }
+    for (size_t i = 0; i < MAX_ROWS; ++i) { id = (int)i * 7 + 1; n = 0; doda_select_where_eq(&t, "id", &id, count_cb, &n); bad += n != (i % 3 ? 1u : 0u); }
+    printf("pk chain delete: deleted=%zu lookup mismatches=%zu\n", del, bad);
+
+    // The table is full except for freed slots, so this insert must reuse one
+    id = MAX_ROWS * 7 + 1; v = -1; st = doda_insert_row(&t, vals);
+    n = 0; doda_select_where_eq(&t, "id", &id, count_cb, &n);
+    printf("pk slot reuse: status=%d found=%zu high-water=%zu free=%zu\n", (int)st, n, t.count, (size_t)t.free_top);
+}
+
 #ifdef DRIVERSQL_TIMESERIES
 static void test_timeseries(void) {
     const char *cols[] = {"id", "time", "value"};
@@ -65,11 +99,262 @@ static void test_aggregations(void) {
     cnt = agg_count((const Table *)&t); printf("count(rows)=%zu\n", cnt);
 }
 
+// GROUP BY test
+static void test_group_by(void) {
+    const char *cols[] = {"id", "time", "device", "value"};
+    DodaColumnType types[] = {COL_INT, COL_INT, COL_INT, COL_INT};
+    DodaTable t; doda_init_table(&t, "fleet", 4, cols, types);
+    for (int i = 0; i < 12; ++i) {
+        int id = i + 1, time = 1000 + i * 100, device = i % 3, value = 10 * (i % 3) + i;
+        const void *vals[4]; vals[0] = &id; vals[1] = &time; vals[2] = &device; vals[3] = &value;
+        doda_insert_row(&t, vals);
+    }
+    DodaGroupBy gb;
+    if (doda_agg_group_by(&t, "device", "value", "time", 1200, 2000, &gb) == DodaStatus_OK) {
+        for (size_t i = 0; i < gb.size; ++i) {
+            const DodaGroupAgg *g = &gb.groups[i];
+            printf("device=%d count=%zu sum=%lld min=%d max=%d avg=%.2f\n", g->key, g->count, g->sum, g->min, g->max, g->avg);
+        }
+    }
+
+    const char *tcols[] = {"id", "name", "age"};
+    DodaColumnType ttypes[] = {COL_INT, COL_TEXT, COL_INT};
+    DodaTable p; doda_init_table(&p, "people", 3, tcols, ttypes);
+    doda_insert_row_int_text_int(&p, 1, "Alice", 30);
+    doda_insert_row_int_text_int(&p, 2, "Bob", 22);
+    doda_insert_row_int_text_int(&p, 3, "Alice", 40);
+    if (doda_agg_group_by(&p, "name", "age", NULL, 0, 0, &gb) == DodaStatus_OK) {
+        for (size_t i = 0; i < gb.size; ++i) printf("name=%s count=%zu avg(age)=%.2f\n", p.columns[gb.key_column].data.text_data[gb.groups[i].key_row], gb.groups[i].count, gb.groups[i].avg);
+    }
+}
+
+// As-of join test
+static void asof_cb(const DodaTable *left, size_t lrow, const DodaTable *right, size_t rrow, void *user) {
+    (void)user;
+    if (rrow == DODA_NO_ROW) printf("temp@%d=%d pressure=none\n", left->columns[1].data.int_data[lrow], left->columns[2].data.int_data[lrow]);
+    else printf("temp@%d=%d pressure@%d=%d\n", left->columns[1].data.int_data[lrow], left->columns[2].data.int_data[lrow], right->columns[1].data.int_data[rrow], right->columns[2].data.int_data[rrow]);
+}
+
+static void interp_cb(const DodaTable *left, size_t lrow, double value, void *user) {
+    (void)user; printf("temp@%d pressure~%.2f\n", left->columns[1].data.int_data[lrow], value);
+}
+
+static void test_asof_join(void) {
+    const char *cols[] = {"id", "time", "value"};
+    DodaColumnType types[] = {COL_INT, COL_INT, COL_INT};
+    DodaTable temp, pres; doda_init_table(&temp, "temp", 3, cols, types); doda_init_table(&pres, "pressure", 3, cols, types);
+    DodaTSDB lt, rt; doda_tsdb_init(&lt, &temp, "time"); doda_tsdb_init(&rt, &pres, "time");
+    doda_tsdb_append_int3(&lt, 1, 900, 20);
+    doda_tsdb_append_int3(&lt, 2, 1100, 21);
+    doda_tsdb_append_int3(&lt, 3, 1500, 22);
+    doda_tsdb_append_int3(&lt, 4, 2600, 23);
+    // Right side out of physical order: joined through a time index
+    doda_tsdb_append_int3(&rt, 1, 1400, 1014);
+    doda_tsdb_append_int3(&rt, 2, 1000, 1010);
+    doda_tsdb_append_int3(&rt, 3, 2000, 1020);
+    DodaIndex ridx; doda_tsdb_build_time_index(&rt, &ridx);
+    doda_tsdb_asof_join(&lt, NULL, &rt, &ridx, 500, asof_cb, NULL);
+    doda_tsdb_asof_interp(&lt, NULL, &rt, &ridx, "value", interp_cb, NULL);
+}
+
+// Sliding window test
+static void test_windows(void) {
+    const char *cols[] = {"id", "time", "value"};
+    DodaColumnType types[] = {COL_INT, COL_INT, COL_INT};
+    DodaTable t; doda_init_table(&t, "loop", 3, cols, types);
+    DodaTSDB ts; doda_tsdb_init(&ts, &t, "time");
+    DodaWindow last4, span; doda_window_init(&last4, DODA_WIN_COUNT, 4, 0.5); doda_window_init(&span, DODA_WIN_TIME, 300, 0.0);
+    doda_tsdb_attach_window(&ts, &last4, "value"); doda_tsdb_attach_window(&ts, &span, "value");
+    const int samples[] = {5, 9, 3, 7, 8, 2};
+    for (int i = 0; i < 6; ++i) doda_tsdb_append_int3(&ts, i + 1, 1000 + i * 100, samples[i]);
+    double avg = 0.0, rate = 0.0, ewma = 0.0; int minv = 0, maxv = 0, delta = 0;
+    doda_window_avg(&last4, &avg); doda_window_min(&last4, &minv); doda_window_max(&last4, &maxv); doda_window_ewma(&last4, &ewma);
+    printf("last4: n=%zu avg=%.2f min=%d max=%d ewma=%.3f\n", doda_window_count(&last4), avg, minv, maxv, ewma);
+    doda_window_delta(&span, &delta); doda_window_rate(&span, &rate); doda_window_min(&span, &minv);
+    printf("span300: n=%zu delta=%d rate=%.3f min=%d\n", doda_window_count(&span), delta, rate, minv);
+    size_t deleted = 0; doda_tsdb_delete_older_than(&ts, 1400, &deleted);
+    doda_window_min(&last4, &minv); doda_window_max(&last4, &maxv);
+    printf("after retention: deleted=%zu last4 n=%zu min=%d max=%d\n", deleted, doda_window_count(&last4), minv, maxv);
+    DodaWindow big; printf("count window > WINDOW_MAX -> %d\n", (int)doda_window_init(&big, DODA_WIN_COUNT, DRIVERSQL_WINDOW_MAX + 1, 0.0));
+}
+
+#ifdef DRIVERSQL_STATS
+// Stats test: a fake clock advancing 10 ticks per read
+static uint64_t fake_ticks;
+static uint64_t fake_clock(void) { return fake_ticks += 10; }
+
+static void test_stats(void) {
+    const char *cols[] = {"id", "time", "value"};
+    DodaColumnType types[] = {COL_INT, COL_INT, COL_INT};
+    DodaTable t; doda_init_table(&t, "stats", 3, cols, types);
+    doda_stats_reset(); doda_stats_set_clock(fake_clock);
+    DodaTSDB ts; doda_tsdb_init(&ts, &t, "time");
+    for (int i = 0; i < 8; ++i) doda_tsdb_append_int3(&ts, i + 1, 1000 + i * 10, i);
+    size_t hits = 0; int t0 = 1040; doda_tsdb_select_time_ge(&ts, t0, count_cb, &hits);
+    DodaStats st; doda_stats_snapshot(&st);
+    printf("stats: inserts=%llu scanned=%llu matched=%llu pk_probes=%llu insert_ticks=%llu\n",
+           (unsigned long long)st.latency[STAT_INSERT_ROW].calls, (unsigned long long)st.rows_scanned, (unsigned long long)st.rows_matched,
+           (unsigned long long)st.pk_probes, (unsigned long long)st.latency[STAT_INSERT_ROW].total_ticks);
+    uint64_t scanned = st.rows_scanned; double avg = 0.0; agg_avg_int(&t, "value", &avg); doda_stats_snapshot(&st);
+    printf("stats: agg_avg scanned %llu rows\n", (unsigned long long)(st.rows_scanned - scanned));
+    doda_stats_set_clock(NULL);
+}
+#endif
+
+// Typed schema test
+#define SENSOR_SCHEMA(X, ctx) \
+    X(ctx, id, INT)           \
+    X(ctx, time, INT)         \
+    X(ctx, temp, FLOAT)       \
+    X(ctx, site, TEXT)
+DODA_SCHEMA(sensor, SENSOR_SCHEMA)
+
+static void typed_print_cb(const Table *tab, size_t row, void *user) {
+    (void)user; sensor_row r; if (sensor_get(tab, row, &r)) printf("sensor id=%d time=%d temp=%.1f site=%s\n", r.id, r.time, r.temp, r.site);
+}
+
+static void test_typed_schema(void) {
+    Table t; sensor_init(&t, "sensors");
+    const sensor_row rows[] = {{1, 1000, 20.5f, "north"}, {2, 1100, 22.0f, "south"}, {3, 1200, 19.0f, "north"}, {4, 1300, 25.5f, "east"}};
+    for (size_t i = 0; i < sizeof(rows) / sizeof(rows[0]); ++i) sensor_insert(&t, &rows[i]);
+    printf("typed duplicate pk -> %d\n", (int)sensor_insert(&t, &rows[0]));
+    size_t n = sensor_select_temp(&t, OP_GT, 20.0f, typed_print_cb, NULL);
+    printf("typed temp > 20: %zu rows\n", n);
+    n = sensor_select_site(&t, OP_EQ, "north", NULL, NULL);
+    printf("typed site == north: %zu rows\n", n);
+    DodaAggFLOAT agg; if (sensor_agg_temp(&t, &agg)) printf("typed temp count=%zu min=%.1f max=%.1f avg=%.2f\n", agg.count, agg.min, agg.max, agg.sum / (double)agg.count);
+}
+
+#ifdef DRIVERSQL_SHM
+// Shared-memory test: writer and read-only reader mappings of the same segment
+static void test_shm(void) {
+    const char *cols[] = {"id", "time", "value"};
+    DodaColumnType types[] = {COL_INT, COL_INT, COL_INT};
+    DodaShm writer, reader;
+    if (doda_shm_create(&writer, "/doda_tests", "shared", 3, cols, types) != DodaStatus_OK) { printf("shm: create failed\n"); return; }
+    DodaTSDB ts; doda_tsdb_init(&ts, doda_shm_table_mut(&writer), "time");
+    doda_shm_write_begin(&writer);
+    for (int i = 0; i < 5; ++i) doda_tsdb_append_int3(&ts, i + 1, 1000 + i * 100, 40 + i);
+    doda_tsdb_build_time_index(&ts, doda_shm_index_mut(&writer, 0));
+    doda_shm_write_end(&writer);
+    if (doda_shm_attach(&reader, "/doda_tests") != DodaStatus_OK) { printf("shm: attach failed\n"); doda_shm_detach(&writer); doda_shm_unlink("/doda_tests"); return; }
+    size_t hits; double avg = 0.0; uint32_t seq;
+    do {
+        if (doda_shm_read_begin(&reader, &seq) != DodaStatus_OK) { printf("shm: writer stuck\n"); break; }
+        hits = 0;
+        int t0 = 1200; doda_index_select_op(doda_shm_table(&reader), doda_shm_index(&reader, 0), DodaOp_GTE, &t0, count_cb, &hits);
+        agg_avg_int(doda_shm_table(&reader), "value", &avg);
+    } while (doda_shm_read_retry(&reader, seq));
+    printf("shm reader: time>=1200 rows=%zu avg(value)=%.2f\n", hits, avg);
+    doda_shm_write_begin(&writer); // simulate a writer that died mid-update
+    printf("shm read_begin with stuck writer -> %d\n", (int)doda_shm_read_begin(&reader, &seq));
+    printf("shm reader write_begin -> %d, table_mut %s\n", (int)doda_shm_write_begin(&reader), doda_shm_table_mut(&reader) ? "non-NULL" : "NULL");
+    // Recreating the segment replaces the object: the attached reader keeps its old mapping
+    DodaShm fresh; DodaStatus st = doda_shm_create(&fresh, "/doda_tests", "shared", 3, cols, types);
+    printf("shm recreate -> %d, old reader still sees %zu rows\n", (int)st, doda_shm_table(&reader)->count);
+    if (st == DodaStatus_OK) doda_shm_detach(&fresh);
+    doda_shm_detach(&reader); doda_shm_detach(&writer); doda_shm_unlink("/doda_tests");
+}
+#endif
+
+// Streaming import/export test through an in-memory byte stream
+typedef struct { char data[4096]; size_t len, pos; } MemStream;
+static size_t mem_write(void *ctx, const void *buf, size_t len) {
+    MemStream *m = (MemStream *)ctx; if (len > sizeof(m->data) - m->len) len = sizeof(m->data) - m->len;
+    memcpy(m->data + m->len, buf, len); m->len += len; return len;
+}
+static size_t fail_write(void *ctx, const void *buf, size_t len) { (void)ctx; (void)buf; return len / 2; }
+
+static size_t mem_read(void *ctx, void *buf, size_t len) {
+    MemStream *m = (MemStream *)ctx; if (len > m->len - m->pos) len = m->len - m->pos;
+    memcpy(buf, m->data + m->pos, len); m->pos += len; return len;
+}
+
+static void test_io(void) {
+    const char *cols[] = {"id", "name", "ok", "temp"};
+    DodaColumnType types[] = {COL_INT, COL_TEXT, COL_BOOL, COL_DOUBLE};
+    static DodaTable src, dst; static DodaLoader ld; DodaExporter ex; static MemStream ms;
+    doda_init_table(&src, "src", 4, cols, types);
+    ms.len = 0; ms.pos = 0;
+    const char *csv = "id,name,ok,temp\n1,alpha,true,20.5\n2,\"b,\"\"eta\"\"\",0,-3.25\nbad,row,1,1\n3,\"gam\nma\",1,7\r\n5,5\"x,1,2\n6,eps,0,3\n4,delta,false,1e3";
+    mem_write(&ms, csv, strlen(csv));
+    doda_loader_init(&ld, &src, mem_read, &ms);
+    DodaStatus st = doda_load_csv(&ld, true);
+    printf("csv load: status=%d loaded=%zu rejected=%zu\n", (int)st, ld.loaded, ld.rejected);
+
+    ms.len = 0; doda_export_init(&ex, mem_write, &ms);
+    doda_export_csv_table(&ex, &src, true);
+    printf("csv export:\n%.*s", (int)ms.len, ms.data);
+    doda_init_table(&dst, "dst", 4, cols, types);
+    ms.pos = 0; doda_loader_init(&ld, &dst, mem_read, &ms);
+    st = doda_load_csv(&ld, true);
+    printf("csv reload: status=%d loaded=%zu rejected=%zu\n", (int)st, ld.loaded, ld.rejected);
+
+    ms.len = 0; ms.pos = 0; doda_export_init(&ex, mem_write, &ms);
+    doda_export_bin_begin(&ex, &src);
+    int t0 = 2; doda_select_where_op(&src, "id", DodaOp_GTE, &t0, doda_export_row_cb, &ex);
+    doda_export_finish(&ex);
+    doda_init_table(&dst, "dst", 4, cols, types);
+    doda_loader_init(&ld, &dst, mem_read, &ms);
+    st = doda_load_bin(&ld);
+    printf("bin round trip (id >= 2): status=%d bytes=%zu loaded=%zu\n", (int)st, ms.len, ld.loaded);
+    for (size_t r = 0; r < dst.count; ++r) if (!doda_is_deleted(&dst, r)) doda_print_row(&dst, r);
+    doda_export_init(&ex, fail_write, NULL);
+    printf("csv export short write: %d\n", (int)doda_export_csv_table(&ex, &src, true));
+}
+
+// Bitmap predicates: alarm AND NOT ack AND status IN (2,3)
+static void test_bitmap(void) {
+    const char *cols[] = {"id", "alarm", "ack", "status"};
+    DodaColumnType types[] = {COL_INT, COL_BOOL, COL_BOOL, COL_INT};
+    static DodaTable t; DodaBitmapIndex bm; DodaRowSet hits, acked, in_status;
+    doda_init_table(&t, "alarms", 4, cols, types);
+    for (int i = 1; i <= 100; ++i) { int alarm = i % 2, ack = i % 3 == 0, status = i % 5; const void *vals[4] = {&i, &alarm, &ack, &status}; doda_insert_row(&t, vals); }
+    printf("bitmap build: %d\n", (int)doda_bitmap_index_build(&t, &bm, "status"));
+    const int wanted[] = {2, 3};
+    doda_rowset_from_bool(&t, "alarm", true, &hits);
+    doda_rowset_from_bool(&t, "ack", true, &acked);
+    doda_rowset_from_bitmap_in(&t, &bm, wanted, 2, &in_status);
+    doda_rowset_andnot(&hits, &acked); doda_rowset_and(&hits, &in_status);
+    printf("alarm AND NOT ack AND status IN (2,3): %zu rows\n", doda_rowset_count(&t, &hits));
+    int id = 3; size_t del = 0; doda_delete_where_eq(&t, "id", &id, &del);
+    id = 7; doda_delete_where_eq(&t, "id", &id, &del);
+    printf("after deleting ids 3,7:\n");
+    printf("selected %zu rows\n", doda_rowset_select(&t, &hits, print_cb, NULL));
+    size_t n = 0; int yes = 1; doda_select_where_op(&t, "ack", DodaOp_LT, &yes, count_cb, &n);
+    printf("ack < true: %zu rows\n", n);
+    doda_delete_where_eq(&t, "ack", &yes, &del);
+    printf("deleted acked: %zu, remaining: %zu\n", del, agg_count(&t));
+    // Fill the tail so the next insert reuses a freed slot with a status its old row did not have
+    int alarm = 0, ack = 0, status = 0; const void *vals[4] = {&id, &alarm, &ack, &status};
+    for (id = 1000; t.count < t.capacity; ++id) doda_insert_row(&t, vals);
+    id = 500; alarm = 1; status = 4; doda_insert_row(&t, vals);
+    DodaRowSet st4; printf("stale bitmap query: %d (free slots left: %zu)\n", (int)doda_rowset_from_bitmap_eq(&t, &bm, 4, &st4), (size_t)t.free_top);
+    printf("bitmap refresh: %d\n", (int)doda_bitmap_index_refresh(&t, &bm));
+    doda_rowset_from_bitmap_eq(&t, &bm, 4, &st4);
+    n = 0; doda_select_where_eq(&t, "status", &status, count_cb, &n);
+    printf("status == 4: bitmap %zu rows, scan %zu rows\n", doda_rowset_count(&t, &st4), n);
+    DodaBitmapIndex wide; printf("bitmap on id (too many values): %d\n", (int)doda_bitmap_index_build(&t, &wide, "id"));
+}
+
 int main(void) {
     // test_basic();
 #ifdef DRIVERSQL_TIMESERIES
     // test_timeseries();
 #endif
+    test_pk_delete();
     test_aggregations();
+    test_group_by();
+    test_asof_join();
+    test_windows();
+    test_typed_schema();
+    test_io();
+    test_bitmap();
+#ifdef DRIVERSQL_SHM
+    test_shm();
+#endif
+#ifdef DRIVERSQL_STATS
+    test_stats();
+#endif
     return 0;
 }